@@ -50,6 +50,17 @@
 #define AT_STATX_DONT_SYNC	0x4000
 #define AT_RECURSIVE		0x8000	/* Apply to the entire subtree.  */
 
+#ifndef FUTEX_WAIT
+#define FUTEX_WAIT             0          /* Sleep while *uaddr == val */
+#define FUTEX_WAKE             1          /* Wake up to val waiters */
+#define FUTEX_WAIT_BITSET      9          /* FUTEX_WAIT with an absolute timeout and a wake mask */
+#define FUTEX_WAKE_BITSET      10         /* FUTEX_WAKE limited to waiters matching the mask */
+#define FUTEX_PRIVATE_FLAG     128        /* Futex is private to the process */
+#define FUTEX_CLOCK_REALTIME   256        /* Absolute timeouts use CLOCK_REALTIME */
+#define FUTEX_CMD_MASK         ~(FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME)
+#define FUTEX_BITSET_MATCH_ANY 0xffffffff /* Mask matching every waiter */
+#endif
+
 struct clone_args {
     uint64_t flags;        /* Flags bit mask */
     uint64_t pidfd;        /* Where to store PID file descriptor (int *) */
@@ -2822,9 +2822,13 @@ int rev_keyctl(int cmd, unsigned long arg2, unsigned long arg3, unsigned long ar
 int rev_fork(){
   int rc;
   asm volatile (
+    "li a0, 0 \n\t"
+    "li a1, 0 \n\t"
     "li a7, 220 \n\t"
     "ecall \n\t"
     "mv %0, a0" : "=r" (rc)
+    :
+    : "a0", "a1", "a7", "memory"
     );
   return rc;
 }
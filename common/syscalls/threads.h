@@ -0,0 +1,83 @@
+//
+// _threads_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+// Raw system call and thread creation helpers for the guest tests
+//
+
+#ifndef _REV_THREADS_H_
+#define _REV_THREADS_H_
+
+#ifndef CLONE_VM
+#define CLONE_VM             0x00000100 /* Set if VM shared between processes */
+#define CLONE_FS             0x00000200 /* Set if fs info shared between processes */
+#define CLONE_FILES          0x00000400 /* Set if open files shared between processes */
+#define CLONE_SIGHAND        0x00000800 /* Set if signal handlers shared */
+#define CLONE_THREAD         0x00010000 /* Set to add to same thread group */
+#define CLONE_SYSVSEM        0x00040000 /* Set to shared SVID SEM_UNDO semantics */
+#define CLONE_SETTLS         0x00080000 /* Set TLS info */
+#define CLONE_PARENT_SETTID  0x00100000 /* Store TID in userlevel buffer before MM copy */
+#define CLONE_CHILD_CLEARTID 0x00200000 /* Register exit futex and memory location to clear */
+#endif
+
+#ifndef AT_FDCWD
+#define AT_FDCWD             -100       /* *at functions use the current working directory */
+#endif
+
+/* The clone flags pthread_create uses, minus CLONE_SETTLS */
+#define REV_THREAD_FLAGS (CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND | \
+                          CLONE_THREAD | CLONE_SYSVSEM | CLONE_PARENT_SETTID | \
+                          CLONE_CHILD_CLEARTID)
+
+/* Issue system call n with up to four arguments */
+static inline long rev_syscall4(long n, long a, long b, long c, long d){
+  register long a0 asm("a0") = a;
+  register long a1 asm("a1") = b;
+  register long a2 asm("a2") = c;
+  register long a3 asm("a3") = d;
+  register long a7 asm("a7") = n;
+  asm volatile("ecall" : "+r"(a0) : "r"(a1), "r"(a2), "r"(a3), "r"(a7) : "memory");
+  return a0;
+}
+
+/*
+ * pthread_create in miniature: the child calls fn(arg) on the stack
+ * ending at stack_top and exits; the kernel stores its TID in *tid and
+ * clears it again (waking any futex waiter) once the child is gone.
+ * Returns the child's TID, or a negative errno.
+ */
+static inline int rev_thread_spawn(void (*fn)(long), long arg, char *stack_top,
+                                   volatile int *tid){
+  int rc;
+  asm volatile(
+    "mv t0, %1 \n\t"
+    "mv t1, %2 \n\t"
+    "li a0, %5 \n\t"
+    "mv a1, %3 \n\t"
+    "mv a2, %4 \n\t"
+    "li a3, 0 \n\t"
+    "mv a4, %4 \n\t"
+    "li a7, 220 \n\t"
+    "ecall \n\t"
+    "bnez a0, 1f \n\t"
+    "mv a0, t1 \n\t"
+    "jalr t0 \n\t"
+    "li a0, 0 \n\t"
+    "li a7, 93 \n\t"
+    "ecall \n\t"
+    "1: \n\t"
+    "mv %0, a0 \n\t"
+    : "=r"(rc)
+    : "r"(fn), "r"(arg), "r"(stack_top), "r"(tid), "i"(REV_THREAD_FLAGS)
+    : "t0", "t1", "a0", "a1", "a2", "a3", "a4", "a7", "ra", "memory");
+  return rc;
+}
+
+#endif
+
+// EOF
@@ -16,6 +16,7 @@
 #include <queue>
 #include <tuple>
 #include <list>
+#include <string>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -36,11 +37,15 @@
 #include "PanNet.h"
 #include "PanExec.h"
 #include "RevCoProc.h"
+#include "RevThreadPool.h"
+#include "RevThreadSched.h"
+#include "RevThreadEvent.h"
 
 // -- PAN Common Headers
 #include "../common/include/PanAddr.h"
 
 #define _MAX_PAN_TEST_ 11
+#define _REV_FF_QUANTUM_ 10000    ///< instructions per core before fast-forward rotates cores
 
 namespace SST {
   namespace RevCPU {
@@ -87,8 +92,26 @@ namespace SST {
       SST_ELI_DOCUMENT_PARAMS(
         {"verbose",         "Sets the verbosity level of output",           "0" },
         {"clock",           "Clock for the CPU",                            "1GHz" },
+        {"quantum",         "Core cycles advanced per clock callback (no memH or PAN)", "1" },
+        {"threads",         "Host threads used to clock the cores (no memH, PAN, coProc or faults)", "1" },
+        {"threadSched",     "Schedule cloned guest threads across the cores; core 0 runs main", "0" },
+        {"threadQuantum",   "Cycles a scheduled guest thread runs before it may be preempted (0 disables)", "0" },
+        {"threadSteal",     "Let idle cores steal runnable guest threads from busy ones", "1" },
+        {"enable_suspend",  "Suspend the clock while every core waits on memHierarchy", "1" },
+        {"syscallLatency",  "Fixed cycles charged to a syscall that copies a guest buffer", "0" },
+        {"syscallBandwidth","Bytes per cycle charged to a guest buffer copied without memHierarchy (0 is free)", "8" },
         {"program",         "Sets the binary executable",                   "a.out" },
         {"args",            "Sets the argument list",                       ""},
+        {"snapshot",        "Post-load image snapshot file; restored if current, otherwise written", ""},
+        {"checkpoint",      "Architectural checkpoint file written at the checkpoint trigger", ""},
+        {"checkpointCycle", "Cycle at which to write the checkpoint",       "0"},
+        {"checkpointInst",  "Retired instruction count (all cores) at which to write the checkpoint", "0"},
+        {"checkpointExit",  "Exit the simulation once the checkpoint is written", "0"},
+        {"restore",         "Architectural checkpoint file to resume from", ""},
+        {"fastForward",     "Functionally execute until N instructions, sym:SYMBOL or the addi x0,x0,1 marker", ""},
+        {"sampleFunctional","Functional instructions between sampled detailed windows (0 disables sampling)", "0"},
+        {"sampleWarmup",    "Timed but unmeasured warm-up instructions before each window", "0"},
+        {"sampleDetailed",  "Measured detailed instructions per sampled window", "0"},
         {"numCores",        "Number of RISC-V cores to instantiate",        "1" },
         {"memSize",         "Main memory size in bytes",                    "1073741824"},
         {"startAddr",       "Starting PC of the target core",               "core:0x80000000"},
@@ -96,12 +119,24 @@ namespace SST {
         {"machine",         "RISC-V machine model of the target core",      "core:G"},
         {"memCost",         "Memory latency range in cycles min:max",       "core:0:10"},
         {"prefetchDepth",   "Instruction prefetch depth per core",          "core:1"},
+        {"prefetchStreams", "Instruction prefetch stream slots per core",   "core:8"},
         {"table",           "Instruction cost table",                       "core:/path/to/table"},
         {"enable_nic",      "Enable the internal RevNIC",                   "0"},
         {"enable_pan",      "Enable PAN network endpoint",                  "0"},
         {"enable_test",     "Enable PAN network endpoint test",             "0"},
         {"enable_pan_stats","Enable PAN network statistics",                "1"},
         {"enable_memH",     "Enable memHierarchy",                          "0"},
+        {"enable_preload",  "Preload the program image into memHierarchy during init", "1"},
+        {"memRanks",        "Number of RevCPU components sharing one memHierarchy backend", "1"},
+        {"memRank",         "Index of this component among those sharing the memHierarchy backend", "0"},
+        {"enable_l1",       "Enable the internal L1 cache model (no memH)", "0"},
+        {"l1Size",          "Internal L1 cache size in bytes",              "32768"},
+        {"l1Ways",          "Internal L1 cache associativity",              "8"},
+        {"l1LineSize",      "Internal L1 cache line size in bytes",         "64"},
+        {"l1HitLatency",    "Internal L1 cache hit latency in cycles",      "1"},
+        {"l1MissLatency",   "Internal L1 cache miss latency in cycles",     "10"},
+        {"l1WriteBack",     "Internal L1 cache write-back (1) or write-through (0)", "1"},
+        {"l1WriteAllocate", "Internal L1 cache allocates lines on write misses", "1"},
         {"enableRDMAMbox",  "Enable the RDMA mailbox",                      "1"},
         {"enableCoProc",    "Enable an attached coProcessor for all cores", "0"},
         {"enable_faults",   "Enable the fault injection logic",             "0"},
@@ -118,6 +153,7 @@ namespace SST {
       // RevCPU Port Parameter Data
       // -------------------------------------------------------
       SST_ELI_DOCUMENT_PORTS(
+        {"sched_%(memRanks)d", "Link to the component of the given memRank; carries guest threads between components sharing a memory backend", {"revcpu.RevThreadEvent"}}
       )
 
       // -------------------------------------------------------
@@ -195,6 +231,15 @@ namespace SST {
         {"TLBMisses",           "TLB misses",                                           "count",  1},
         {"TLBHitsPerCore",      "TLB hits per core",                                    "count",  1},
         {"TLBMissesPerCore",    "TLB misses per core",                                  "count",  1},
+        {"L1Hits",              "Internal L1 cache line hits",                          "count",  1},
+        {"L1Misses",            "Internal L1 cache line misses",                        "count",  1},
+        {"L1Writebacks",        "Internal L1 cache dirty line writebacks",              "count",  1},
+        {"SampleWindows",       "Number of measured sampling windows",                  "count",  1},
+        {"SampledInsts",        "Instructions measured in the sampling windows",        "count",  1},
+        {"EstimatedCycles",     "Whole-program cycles extrapolated from the sampled CPI", "count", 1},
+        {"ThreadsSpawned",      "Guest threads placed by the thread scheduler",         "count",  1},
+        {"ThreadSteals",        "Guest threads stolen by idle cores",                   "count",  1},
+        {"ThreadPreemptions",   "Guest threads preempted at the end of their quantum",  "count",  1},
       )
 
     private:
@@ -229,6 +274,20 @@ namespace SST {
       bool EnableRDMAMBox;                ///< RevCPU: Enable the RDMA Mailbox
 
       bool EnableMemH;                    ///< RevCPU: Enable memHierarchy
+      bool EnableL1;                      ///< RevCPU: Enable the internal L1 cache model
+      unsigned Quantum;                   ///< RevCPU: core cycles advanced per clock callback
+      RevThreadPool *Pool;                ///< RevCPU: host threads clocking the cores (null when serial)
+      RevThreadSched *Sched;              ///< RevCPU: guest thread scheduler (null when threads are pinned)
+      unsigned MemRank;                   ///< RevCPU: index of this component among those sharing the memory backend
+      unsigned MemRanks;                  ///< RevCPU: number of components sharing the memory backend
+      std::vector<SST::Link*> SchedLinks; ///< RevCPU: links to the other components, indexed by memRank
+      uint64_t Exported;                  ///< RevCPU: new threads dealt round-robin over the components
+      bool RemoteReleased;                ///< RevCPU: the other components have been told no more threads will arrive
+      std::vector<uint8_t> Finished;      ///< RevCPU: cores that completed during a parallel quantum
+      bool EnableSuspend;                 ///< RevCPU: suspend the clock while all cores wait on memory
+      bool Suspended;                     ///< RevCPU: the clock handler is currently unregistered
+      SST::Cycle_t SuspendCycle;          ///< RevCPU: last cycle clocked before suspending
+      SST::Clock::HandlerBase *ClockHandler; ///< RevCPU: registered clock handler
       bool EnableCoProc;                  ///< RevCPU: Enable a co-processor attached to all cores
 
       bool EnableFaults;                  ///< RevCPU: Enable fault injection logic
@@ -237,6 +296,31 @@ namespace SST {
       bool EnableRegFaults;               ///< RevCPU: Enable register faults
       bool EnableALUFaults;               ///< RevCPU: Enable ALU faults
 
+      std::string CkptFile;               ///< RevCPU: architectural checkpoint file
+      uint64_t CkptCycle;                 ///< RevCPU: cycle that triggers the checkpoint
+      uint64_t CkptInst;                  ///< RevCPU: retired instruction count that triggers the checkpoint
+      bool CkptExit;                      ///< RevCPU: exit once the checkpoint is written
+      bool CkptPending;                   ///< RevCPU: cores are draining for a checkpoint
+      bool CkptDone;                      ///< RevCPU: the checkpoint has been written
+
+      /// RevCPU: sampled simulation phase
+      typedef enum{
+        SampleOff         = 0,            ///< SamplePhase: sampling is disabled
+        SampleDrain       = 1,            ///< SamplePhase: draining before a functional period
+        SampleFunctional  = 2,            ///< SamplePhase: functional execution
+        SampleWarmup      = 3,            ///< SamplePhase: timed, unmeasured warm-up
+        SampleDetailed    = 4             ///< SamplePhase: timed, measured window
+      }SamplePhase;
+
+      SamplePhase SampleState;            ///< RevCPU: current sampling phase
+      uint64_t SampleFunc;                ///< RevCPU: functional instructions per sampling period
+      uint64_t SampleWarm;                ///< RevCPU: warm-up instructions per sampling period
+      uint64_t SampleDetail;              ///< RevCPU: measured instructions per sampling period
+      uint64_t SampleMark;                ///< RevCPU: retired instruction count at the start of the phase
+      SST::Cycle_t SampleStart;           ///< RevCPU: cycle at the start of the phase
+      uint64_t SampleInsts;               ///< RevCPU: total measured instructions
+      std::vector<double> SampleCPI;      ///< RevCPU: CPI of each measured window
+
       bool ReadyForRevoke;                ///< RevCPU: Is the CPU ready for revocation?
       bool RevokeHasArrived;              ///< RevCPU: Determines whether the REVOKE command has arrived
 
@@ -331,6 +415,15 @@ namespace SST {
       std::vector<Statistic<uint64_t>*> FloatsExec;
       std::vector<Statistic<uint64_t>*> TLBMissesPerCore;
       std::vector<Statistic<uint64_t>*> TLBHitsPerCore;
+      Statistic<uint64_t>* L1Hits;
+      Statistic<uint64_t>* L1Misses;
+      Statistic<uint64_t>* L1Writebacks;
+      Statistic<uint64_t>* SampleWindows;
+      Statistic<uint64_t>* SampledInsts;
+      Statistic<uint64_t>* EstimatedCycles;
+      Statistic<uint64_t>* ThreadsSpawned;
+      Statistic<uint64_t>* ThreadSteals;
+      Statistic<uint64_t>* ThreadPreemptions;
 
       //-------------------------------------------------------
       // -- FUNCTIONS
@@ -492,6 +585,48 @@ namespace SST {
       /// RevCPU: updates sst statistics on a per core basis
       void UpdateCoreStatistics(uint16_t coreNum);
 
+      /// RevCPU: drives the checkpoint trigger and drain; returns true when the simulation should exit
+      bool CheckpointTick(SST::Cycle_t currentCycle);
+
+      /// RevCPU: writes the architectural checkpoint of all quiesced cores
+      bool WriteCheckpoint(SST::Cycle_t currentCycle);
+
+      /// RevCPU: restores the architectural state from a checkpoint file
+      bool RestoreCheckpoint(const std::string& File);
+
+      /// RevCPU: functionally executes all cores up to the fast-forward point
+      void FastForward(const std::string& Spec);
+
+      /// RevCPU: functionally executes the cores in quanta; returns the instructions executed
+      uint64_t FastForwardCores(uint64_t Limit, uint64_t StopPC, bool Marker);
+
+      /// RevCPU: retrieve the number of instructions retired across all cores
+      uint64_t RetiredInsts();
+
+      /// RevCPU: determines whether every enabled core is drained
+      bool AllQuiescent();
+
+      /// RevCPU: advances the sampled simulation phases
+      void SampleTick(SST::Cycle_t currentCycle);
+
+      /// RevCPU: clocks every core through a quantum on the host thread pool
+      void ClockCoresParallel(SST::Cycle_t currentCycle);
+
+      /// RevCPU: determines whether every enabled core is only waiting on memory
+      bool AllMemoryBlocked();
+
+      /// RevCPU: reregisters a suspended clock and accounts for the skipped cycles
+      void WakeClock();
+
+      /// RevCPU: offers a new guest thread to the other components; returns true if one took it
+      bool ExportThread(std::shared_ptr<RevThreadCtx> Ctx);
+
+      /// RevCPU: tells the other components that no more threads will be exported
+      void ReleaseRemotes();
+
+      /// RevCPU: receives guest threads from the other components sharing the memory backend
+      void handleThreadEvent(SST::Event *ev);
+
     }; // class RevCPU
   } // namespace RevCPU
 } // namespace SST
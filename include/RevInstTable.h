@@ -253,9 +253,6 @@ namespace SST{
       unsigned Entry;                   ///< RevRegFile: Instruction entry
     }RevRegFile;                        ///< RevProc: register file construct
 
-    static std::bitset<_REV_HART_COUNT_> HART_CTS; ///< RevProc: Thread is clear to start (proceed with decode)
-    static std::bitset<_REV_HART_COUNT_> HART_CTE; ///< RevProc: Thread is clear to execute (no register dependencides)
-
     typedef enum{
       RVTypeUNKNOWN = 0,  ///< RevInstf: Unknown format
       RVTypeR       = 1,  ///< RevInstF: R-Type
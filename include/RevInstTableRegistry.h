@@ -0,0 +1,75 @@
+//
+// _RevInstTableRegistry_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVINSTTABLEREGISTRY_H_
+#define _SST_REVCPU_REVINSTTABLEREGISTRY_H_
+
+// -- C++ Headers
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// -- RevCPU Headers
+#include "RevInstTable.h"
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevInstTableSet
+    // ----------------------------------------
+    // Decode and cost tables for a single machine model and cost
+    // table.  Once registered, a set is never modified and is shared
+    // by every core that uses the same configuration.
+    class RevInstTableSet {
+    public:
+      std::vector<RevInstEntry> InstTable;        ///< RevInstTableSet: merged instruction table
+      std::vector<std::string> ExtNames;          ///< RevInstTableSet: names of the enabled extensions
+
+      std::map<std::string,unsigned> NameToEntry; ///< RevInstTableSet: instruction mnemonic to table entry mapping
+      std::map<uint32_t,unsigned> EncToEntry;     ///< RevInstTableSet: instruction encoding to table entry mapping
+      std::map<uint32_t,unsigned> CEncToEntry;    ///< RevInstTableSet: compressed instruction encoding to table entry mapping
+
+      std::map<unsigned,std::pair<unsigned,unsigned>> EntryToExt;     ///< RevInstTableSet: instruction entry to extension mapping
+                                                                      ///           first = Master table entry number
+                                                                      ///           second = pair<Extension Index, Extension Entry>
+    }; // class RevInstTableSet
+
+    // ----------------------------------------
+    // RevInstTableRegistry
+    // ----------------------------------------
+    class RevInstTableRegistry {
+    public:
+      /// RevInstTableRegistry: retrieve the tables for the machine model and cost table; nullptr if not yet built
+      static std::shared_ptr<const RevInstTableSet> Find( const std::string& Machine,
+                                                          const std::string& Table );
+
+      /// RevInstTableRegistry: register a newly built set; returns the set already registered if another core won the race
+      static std::shared_ptr<const RevInstTableSet> Insert( const std::string& Machine,
+                                                            const std::string& Table,
+                                                            std::shared_ptr<const RevInstTableSet> Set );
+
+    private:
+      static std::mutex Lock;                                                   ///< RevInstTableRegistry: registry lock
+      static std::map<std::string,std::shared_ptr<const RevInstTableSet>> Sets; ///< RevInstTableRegistry: registered table sets
+
+      /// RevInstTableRegistry: builds the registry key
+      static std::string Key( const std::string& Machine, const std::string& Table ){
+        return Machine + ":" + Table;
+      }
+    }; // class RevInstTableRegistry
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVINSTTABLEREGISTRY_H_
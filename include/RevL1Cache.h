@@ -0,0 +1,91 @@
+//
+// _RevL1Cache_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVL1CACHE_H_
+#define _SST_REVCPU_REVL1CACHE_H_
+
+// -- C++ Headers
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cinttypes>
+
+// -- SST Headers
+#include <sst/core/sst_config.h>
+#include <sst/core/output.h>
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevL1Cache
+    // ----------------------------------------
+    // Lightweight set-associative L1 model used by RevMem when
+    // memHierarchy is disabled.  Only tags are modeled; the data
+    // always lives in the RevMem backing store.
+    class RevL1Cache {
+    public:
+      /// RevL1Cache: constructor
+      RevL1Cache( uint64_t Size, unsigned Ways, unsigned LineSize,
+                  unsigned HitLatency, unsigned MissLatency,
+                  bool WriteBack, bool WriteAllocate,
+                  SST::Output *Output );
+
+      /// RevL1Cache: destructor
+      ~RevL1Cache();
+
+      /// RevL1Cache: access the cache and return the latency in cycles
+      unsigned Access( uint64_t Addr, size_t Len, bool Write );
+
+      /// RevL1Cache: retrieve the number of line hits
+      uint64_t GetHits() { return Hits; }
+
+      /// RevL1Cache: retrieve the number of line misses
+      uint64_t GetMisses() { return Misses; }
+
+      /// RevL1Cache: retrieve the number of dirty line writebacks
+      uint64_t GetWritebacks() { return Writebacks; }
+
+      /// RevL1Cache: retrieve the line size in bytes
+      unsigned GetLineSize() { return lineSize; }
+
+    private:
+      /// RevL1Cache: tag entry
+      typedef struct{
+        uint64_t Tag;             ///< line address held in the way
+        uint64_t LastUse;         ///< access stamp used for LRU replacement
+        bool Valid;               ///< way holds a valid line
+        bool Dirty;               ///< line has been written (write-back only)
+      }L1Line;
+
+      unsigned numSets;           ///< RevL1Cache: number of sets
+      unsigned ways;              ///< RevL1Cache: associativity
+      unsigned lineSize;          ///< RevL1Cache: line size in bytes
+      unsigned hitLatency;        ///< RevL1Cache: latency of a hit in cycles
+      unsigned missLatency;       ///< RevL1Cache: latency of a miss in cycles
+      bool writeBack;             ///< RevL1Cache: write-back (true) or write-through (false)
+      bool writeAllocate;         ///< RevL1Cache: allocate lines on write misses
+      SST::Output *output;        ///< RevL1Cache: output handler
+
+      uint64_t Stamp;             ///< RevL1Cache: monotonic access counter
+      uint64_t Hits;              ///< RevL1Cache: line hits
+      uint64_t Misses;            ///< RevL1Cache: line misses
+      uint64_t Writebacks;        ///< RevL1Cache: dirty lines written back on eviction
+
+      std::vector<L1Line> Tags;   ///< RevL1Cache: tag array [numSets x ways]
+
+      /// RevL1Cache: access a single line and return its latency
+      unsigned AccessLine( uint64_t Line, bool Write );
+    }; // class RevL1Cache
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVL1CACHE_H_
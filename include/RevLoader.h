@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <fstream>
 
 // -- SST Headers
 #include <sst/core/sst_config.h>
@@ -284,6 +285,10 @@ namespace SST {
       /// RevLoader: standard constructor
       RevLoader( std::string Exe, std::string Args, RevMem *Mem, SST::Output *Output );
 
+      /// RevLoader: snapshot constructor; restores from or writes the post-load image snapshot
+      RevLoader( std::string Exe, std::string Args, RevMem *Mem, SST::Output *Output,
+                 std::string Snapshot );
+
       /// RevLoader: standard destructor
       ~RevLoader();
 
@@ -302,6 +307,9 @@ namespace SST {
       /// RevLoader: retrives the elf info structure
       ElfInfo GetInfo() { return elfinfo; }
 
+      /// RevLoader: computes the snapshot key from the executable contents and arguments
+      uint64_t SnapshotKey();
+
     private:
       std::string exe;          ///< RevLoader: binary executable
       std::string args;         ///< RevLoader: program args
@@ -350,6 +358,12 @@ namespace SST {
       ///< Breaks bulk writes into cache lines
       bool WriteCacheLine(uint64_t Addr, size_t Len, void *Data);
 
+      /// Restores the post-load state from a snapshot; returns false if it is missing or stale
+      bool LoadSnapshot(const std::string &File, uint64_t Key);
+
+      /// Writes the post-load state to a snapshot
+      bool DumpSnapshot(const std::string &File, uint64_t Key);
+
       ///< RevLoader: Replaces first MemSegment (initialized to entire memory space) with the static memory
       void InitStaticMem();
 
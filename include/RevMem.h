@@ -22,6 +22,8 @@
 #include <time.h>
 #include <random>
 #include <tuple>
+#include <functional>
+#include <mutex>
 
 // -- SST Headers
 #include <sst/core/sst_config.h>
@@ -31,6 +33,8 @@
 // -- RevCPU Headers
 #include "RevOpts.h"
 #include "RevMemCtrl.h"
+#include "RevL1Cache.h"
+#include "RevSnapshot.h"
 
 #ifndef _REVMEM_BASE_
 #define _REVMEM_BASE_ 0x00000000
@@ -42,6 +46,8 @@
 
 #define _STACK_SIZE_ (1024*1024*sizeof(char))
 
+#define _REVMEM_RANK_PIDS_ 0x100000   ///< PIDs reserved for each component sharing a memory backend
+
 using namespace SST::RevCPU;
 
 namespace SST {
@@ -127,12 +133,27 @@ namespace SST {
       /// RevMem: get the stack_top address
       uint64_t GetStackBottom() { return stacktop - _STACK_SIZE_; }
 
-      /// RevMem: initiate a memory fence
+      /// RevMem: initiate a full memory fence
       bool FenceMem(unsigned Hart);
 
+      /// RevMem: initiate a memory fence ordering the Pred access set before the Succ access set
+      bool FenceMem(unsigned Hart, uint8_t Pred, uint8_t Succ);
+
       /// RevMem: retrieves the cache line size.  Returns 0 if no cache is configured
       unsigned getLineSize(){ if( ctrl ){return ctrl->getLineSize();}else{return 64;} }
 
+      /// RevMem: determines whether loader writes must be timed through the memory controller
+      bool TimedLoads() { return (ctrl != nullptr) && !preload; }
+
+      /// RevMem: enables untimed preloading of the memory controller backend during init
+      void SetPreload(bool Preload) { preload = Preload; }
+
+      /// RevMem: sets whether this instance delivers the program image to a shared memory backend
+      void SetImageOwner(bool Owner) { imageOwner = Owner; }
+
+      /// RevMem: serializes the shared memory state for cores running on host threads
+      void SetThreadSafe(bool Safe) { threadSafe = Safe; }
+
       // ----------------------------------------------------
       // ---- Base Memory Interfaces
       // ----------------------------------------------------
@@ -143,11 +164,24 @@ namespace SST {
       bool WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data,
                      StandardMem::Request::flags_t flags );
 
+      /// RevMem: untimed bulk write; returns false if the write must be timed
+      bool LoadMem( uint64_t Addr, size_t Len, const void *Data );
+
+      /// RevMem: untimed bulk read; returns false if the read must be timed
+      bool ReadBulk( uint64_t Addr, size_t Len, void *Data );
+
+      /// RevMem: untimed bulk write to guest memory; returns false if the write must be timed
+      bool WriteBulk( uint64_t Addr, size_t Len, const void *Data );
+
       /// RevMem: read data from the target memory location
       bool ReadMem( unsigned Hart, uint64_t Addr, size_t Len, void *Target,
                     bool *Hazard,
                     StandardMem::Request::flags_t flags);
 
+      /// RevMem: read instruction words from the target memory location without touching the data L1 model
+      bool ReadInst( unsigned Hart, uint64_t Addr, size_t Len, void *Target,
+                     bool *Hazard );
+
       /// RevMem: DEPRECATED: read data from the target memory location
       [[deprecated("Simple RevMem interfaces have been deprecated")]]
       bool ReadMem( uint64_t Addr, size_t Len, void *Data );
@@ -245,6 +279,9 @@ namespace SST {
                   void *Data, void *Target, uint8_t aq, uint8_t rl,
                   StandardMem::Request::flags_t flags);
 
+      /// RevMem: Drop any memory reservation held by the target hart
+      void ClearReservation(unsigned Hart);
+
       /// RevMem: Initiated an AMO request
       bool AMOMem(unsigned Hart, uint64_t Addr, size_t Len,
                   void *Data, void *Target, bool *Hazard,
@@ -262,9 +299,21 @@ namespace SST {
       /// RevMem: Randomly assign a memory cost
       unsigned RandCost( unsigned Min, unsigned Max );
 
+      /// RevMem: Retrieve the cost of the last data read; falls back to RandCost without an L1
+      unsigned MemCost( unsigned Hart, unsigned Min, unsigned Max );
+
+      /// RevMem: Attach the internal L1 cache model (non-memHierarchy only); RevMem takes ownership
+      void SetL1Cache( RevL1Cache *L1 );
+
+      /// RevMem: Retrieve the internal L1 cache model
+      RevL1Cache *GetL1Cache() { return l1; }
+
       /// RevMem: Used to access & incremenet the global software PID counter
       uint32_t GetNewThreadPID();
 
+      /// RevMem: offsets the PID counter so components sharing a memory backend hand out disjoint PIDs
+      void OffsetPIDs(uint32_t Offset){ PIDCount += Offset; }
+
       /// RevMem: Used to set the size of the TLBSize
       void SetTLBSize(unsigned numEntries){ tlbSize = numEntries; }
 
@@ -306,6 +355,34 @@ namespace SST {
 
       uint64_t ExpandHeap(uint64_t Size);
 
+      /// RevMem: atomically grows the heap so that it ends at Addr; returns the resulting heap end
+      uint64_t Brk(uint64_t Addr);
+
+      /// RevMem: restricts allocations to one slice of a heap shared by Ranks components
+      void PartitionHeap(unsigned Rank, unsigned Ranks);
+
+      /// RevMem: moves the stack below those of the lower ranks sharing the backend
+      void PartitionStack(unsigned Rank, unsigned Ranks);
+
+      /// RevMem: writes the post-load memory image (segments, pages, heap and stack bounds)
+      bool DumpImage(std::ostream &os);
+
+      /// RevMem: restores a memory image written by DumpImage; returns false if it does not match this configuration
+      bool RestoreImage(const char *Buf, size_t Len, size_t &Off);
+
+      /// RevMem: resolves an LR/SC target register to an owning PID and byte offset
+      typedef std::function<bool(uint64_t *, uint32_t &, uint64_t &)> ResolveTargetFunc;
+
+      /// RevMem: rebuilds an LR/SC target register from an owning PID and byte offset
+      typedef std::function<uint64_t *(uint32_t, uint64_t)> RebuildTargetFunc;
+
+      /// RevMem: writes the PID counter, future and LR/SC reservations to a checkpoint
+      bool DumpReservations(std::ostream &os, ResolveTargetFunc Resolve);
+
+      /// RevMem: restores the PID counter, future and LR/SC reservations from a checkpoint
+      bool RestoreReservations(const char *Buf, size_t Len, size_t &Off,
+                               RebuildTargetFunc Rebuild);
+
     class RevMemStats {
     public:
       uint64_t TLBHits;
@@ -333,8 +410,23 @@ namespace SST {
       unsigned maxHeapSize;             ///< RevMem: size of the target memory
       RevOpts *opts;                ///< RevMem: options object
       RevMemCtrl *ctrl;             ///< RevMem: memory controller object
+      bool preload;                 ///< RevMem: loader writes are staged as untimed memory controller writes
+      bool imageOwner = true;       ///< RevMem: loader writes are delivered to the (possibly shared) backend
+      RevL1Cache *l1;               ///< RevMem: internal L1 cache model
       SST::Output *output;          ///< RevMem: output handler
 
+      bool threadSafe = false;          ///< RevMem: cores access memory from multiple host threads
+      std::recursive_mutex memMtx;      ///< RevMem: guards the TLB, page map, segments, reservations and stats
+
+      /// RevMem: scoped lock taken by every entry point when thread safety is enabled
+      class MemGuard {
+      public:
+        MemGuard(RevMem *M) : mtx(M->threadSafe ? &M->memMtx : nullptr) { if( mtx ) mtx->lock(); }
+        ~MemGuard() { if( mtx ) mtx->unlock(); }
+      private:
+        std::recursive_mutex *mtx;
+      };
+
       uint64_t SearchTLB(uint64_t vAddr);                       ///< RevMem: Used to check the TLB for an entry
       void AddToTLB(uint64_t vAddr, uint64_t physAddr);         ///< RevMem: Used to add a new entry to TLB & LRUQueue
       void FlushTLB();                                          ///< RevMem: Used to flush the TLB & LRUQueue
@@ -352,6 +444,12 @@ namespace SST {
       uint64_t heapend;        ///< RevMem: top of the stack
       uint64_t heapstart;        ///< RevMem: top of the stack
       uint64_t stacktop;        ///< RevMem: top of the stack
+      uint64_t heapLimit = 0;        ///< RevMem: end of this component's heap slice (0 when unpartitioned)
+      uint64_t sharedHeapBase = 0;   ///< RevMem: base of the heap shared with other components
+      uint64_t sharedHeapTop = 0;    ///< RevMem: end of the heap shared with other components
+      uint64_t sharedStackBottom = 0; ///< RevMem: bottom of the stacks of every component sharing the backend (0 when unpartitioned)
+
+      std::map<unsigned,unsigned> L1Cost;   ///< RevMem: per-hart L1 latency of the last data read
 
       std::vector<uint64_t> FutureRes;  ///< RevMem: future operation reservations
 
@@ -363,6 +461,14 @@ namespace SST {
       std::vector<std::tuple<unsigned,uint64_t,
                              unsigned,uint64_t*>> LRSC;   ///< RevMem: load reserve/store conditional vector
 
+      /// RevMem: break the reservations other harts hold on a stored range; the caller holds the lock
+      void BreakReservations(unsigned Hart, uint64_t Addr, size_t Len);
+
+      /// RevMem: read data from the target memory location; DataL1 selects whether the data L1 model sees the access
+      bool ReadMem( unsigned Hart, uint64_t Addr, size_t Len, void *Target,
+                    bool *Hazard, StandardMem::Request::flags_t flags,
+                    bool DataL1 );
+
     }; // class RevMem
   } // namespace RevCPU
 } // namespace SST
@@ -22,6 +22,7 @@
 #include <random>
 #include <map>
 #include <tuple>
+#include <functional>
 
 // -- SST Headers
 #include <sst/core/sst_config.h>
@@ -31,6 +32,7 @@
 
 // -- RevCPU Headers
 #include "RevOpts.h"
+#include "RevMemPrefetcher.h"
 
 // RV{32,64} Register Operation Macros
                     //(r) = ((r) & (~r));
@@ -90,6 +92,18 @@ namespace SST {
       F_RL     = 1 << 31      /// AMO RL Flag
     };
 
+    // ----------------------------------------
+    // FENCE predecessor/successor set bits
+    // (matches the pred/succ fields of the FENCE encoding)
+    // ----------------------------------------
+    enum class RevFence {
+      F_FENCE_W    = 1 << 0,  /// memory writes
+      F_FENCE_R    = 1 << 1,  /// memory reads
+      F_FENCE_O    = 1 << 2,  /// device output
+      F_FENCE_I    = 1 << 3,  /// device input
+      F_FENCE_IORW = 0xF      /// all accesses
+    };
+
     // ----------------------------------------
     // RevMemOp
     // ----------------------------------------
@@ -198,6 +212,15 @@ namespace SST {
       /// RevMemOp: set the hazard pointer
       void setHazard(bool *H){ hazard = H;}
 
+      /// RevMemOp: set the cycle the request entered the request queue
+      void setEnqueueTime(uint64_t T){ EnqueueTime = T; }
+
+      /// RevMemOp: set the cycle the request was dispatched to memory
+      void setDispatchTime(uint64_t T){ DispatchTime = T; }
+
+      /// RevMemOp: set the FENCE predecessor and successor sets
+      void setFenceSets(uint8_t Pred, uint8_t Succ){ FencePred = Pred; FenceSucc = Succ; }
+
       /// RevMemOp: retrieve the invalidate flag
       bool getInv() { return Inv; }
 
@@ -213,6 +236,18 @@ namespace SST {
       /// RevMemOp: retrieve the hazard pointer
       bool *getHazard() { return hazard; }
 
+      /// RevMemOp: retrieve the cycle the request entered the request queue
+      uint64_t getEnqueueTime() { return EnqueueTime; }
+
+      /// RevMemOp: retrieve the cycle the request was dispatched to memory
+      uint64_t getDispatchTime() { return DispatchTime; }
+
+      /// RevMemOp: retrieve the FENCE predecessor set
+      uint8_t getFencePred() { return FencePred; }
+
+      /// RevMemOp: retrieve the FENCE successor set
+      uint8_t getFenceSucc() { return FenceSucc; }
+
       // RevMemOp: determine if the request is cache-able
       bool isCacheable() { if( (flags & 0b10) > 0 ){ return false; } return true; }
 
@@ -229,6 +264,10 @@ namespace SST {
       StandardMem::Request::flags_t flags;  ///< RevMemOp: request flags
       void *target;                         ///< RevMemOp: target register pointer
       bool *hazard;                         ///< RevMemOp: load hazard
+      uint8_t FencePred;                    ///< RevMemOp: FENCE predecessor set
+      uint8_t FenceSucc;                    ///< RevMemOp: FENCE successor set
+      uint64_t EnqueueTime;                 ///< RevMemOp: cycle the request was enqueued
+      uint64_t DispatchTime;                ///< RevMemOp: cycle the request was dispatched
     };
 
     // ----------------------------------------
@@ -275,6 +314,10 @@ namespace SST {
                                     uint32_t Size, char *buffer,
                                     StandardMem::Request::flags_t flags) = 0;
 
+      /// RevMemCtrl: stage an untimed write for delivery to the memory backend during init
+      virtual bool sendUntimedWRITERequest(uint64_t Addr, uint32_t Size,
+                                           const char *buffer) = 0;
+
       /// RevMemCtrl: send an AMO request
       virtual bool sendAMORequest(unsigned Hart, uint64_t Addr, uint64_t PAddr,
                                   uint32_t Size, char *buffer, void *target,
@@ -313,8 +356,8 @@ namespace SST {
                                           unsigned Opc,
                                           StandardMem::Request::flags_t flags) = 0;
 
-      /// RevMemCtrl: send a FENCE request
-      virtual bool sendFENCE(unsigned Hart) = 0;
+      /// RevMemCtrl: send a FENCE request ordering the Pred accesses before the Succ accesses
+      virtual bool sendFENCE(unsigned Hart, uint8_t Pred, uint8_t Succ) = 0;
 
       /// RevMemCtrl: handle a read response
       virtual void handleReadResp(StandardMem::ReadResp* ev) = 0;
@@ -340,8 +383,12 @@ namespace SST {
       /// RevMemCtrl: returns the cache line size
       virtual unsigned getLineSize() = 0;
 
+      /// RevMemCtrl: registers a callback invoked after each memory response is handled
+      void setResponseNotify(std::function<void()> Notify){ notify = Notify; }
+
     protected:
       SST::Output *output;        ///< RevMemCtrl: sst output object
+      std::function<void()> notify; ///< RevMemCtrl: response notification callback
     }; // class RevMemCtrl
 
     // ----------------------------------------
@@ -365,10 +412,14 @@ namespace SST {
                               { "max_readlock",   "Sets the maxmium number of outstanding readlock events",   "64"},
                               { "max_writeunlock","Sets the maximum number of outstanding writeunlock events","64"},
                               { "max_custom",     "Sets the maximum number of outstanding custom events",     "64"},
+                              { "max_amo",        "Sets the maximum number of outstanding AMO events (1 to max_loads)", "64"},
+                              { "max_prefetch",   "Sets the maximum number of queued or outstanding data prefetches", "16"},
+                              { "prefetch_track", "Sets the number of prefetched lines tracked for usefulness statistics", "64"},
                               { "ops_per_cycle",  "Sets the maximum number of operations to issue per cycle", "2" }
       )
 
-      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "memIface", "Set the interface to memory", "SST::Interfaces::StandardMem" })
+      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "memIface", "Set the interface to memory", "SST::Interfaces::StandardMem" },
+                                          { "prefetcher", "Set the optional data prefetcher", "SST::RevCPU::RevMemPrefetcher" })
 
       SST_ELI_DOCUMENT_PORTS()
 
@@ -412,7 +463,24 @@ namespace SST {
         {"AMOMaxuBytes",        "Counts the number of bytes in AMOMaxu transactions","bytes", 1},
         {"AMOMaxuPending",      "Counts the number of AMOMaxu operations pending",   "count", 1},
         {"AMOSwapBytes",        "Counts the number of bytes in AMOSwap transactions","bytes", 1},
-        {"AMOSwapPending",      "Counts the number of AMOSwap operations pending",   "count", 1}
+        {"AMOSwapPending",      "Counts the number of AMOSwap operations pending",   "count", 1},
+        {"PrefetchIssued",      "Counts the number of data prefetches issued",       "count", 1},
+        {"PrefetchUseful",      "Counts the number of prefetched lines hit by a demand read after the fill", "count", 1},
+        {"PrefetchLate",        "Counts the number of prefetched lines hit by a demand read before the fill", "count", 1},
+        {"PrefetchUseless",     "Counts the number of prefetched lines never hit by a demand read", "count", 1},
+        {"ReadQueueDelay",      "Cycles reads wait in the request queue before dispatch",           "cycles", 1},
+        {"ReadMemLatency",      "Cycles from read dispatch to completion",                          "cycles", 1},
+        {"ReadTotalLatency",    "Cycles from read enqueue to completion",                           "cycles", 1},
+        {"WriteQueueDelay",     "Cycles writes wait in the request queue before dispatch",          "cycles", 1},
+        {"WriteMemLatency",     "Cycles from write dispatch to completion",                         "cycles", 1},
+        {"WriteTotalLatency",   "Cycles from write enqueue to completion",                          "cycles", 1},
+        {"AMOQueueDelay",       "Cycles AMOs wait in the request queue before dispatch",            "cycles", 1},
+        {"AMOMemLatency",       "Cycles from AMO dispatch to completion of the WRITE",              "cycles", 1},
+        {"AMOTotalLatency",     "Cycles from AMO enqueue to completion of the WRITE",               "cycles", 1},
+        {"OtherQueueDelay",     "Cycles flush/LLSC/lock/custom ops wait in the request queue",      "cycles", 1},
+        {"OtherMemLatency",     "Cycles from flush/LLSC/lock/custom dispatch to completion",        "cycles", 1},
+        {"OtherTotalLatency",   "Cycles from flush/LLSC/lock/custom enqueue to completion",         "cycles", 1},
+        {"RqstQDepth",          "Depth of the request queue sampled every cycle",                   "count", 1}
       )
 
       typedef enum{
@@ -455,7 +523,24 @@ namespace SST {
         AMOMaxuBytes        = 36,
         AMOMaxuPending      = 37,
         AMOSwapBytes        = 38,
-        AMOSwapPending      = 39
+        AMOSwapPending      = 39,
+        PrefetchIssued      = 40,
+        PrefetchUseful      = 41,
+        PrefetchLate        = 42,
+        PrefetchUseless     = 43,
+        ReadQueueDelay      = 44,
+        ReadMemLatency      = 45,
+        ReadTotalLatency    = 46,
+        WriteQueueDelay     = 47,
+        WriteMemLatency     = 48,
+        WriteTotalLatency   = 49,
+        AMOQueueDelay       = 50,
+        AMOMemLatency       = 51,
+        AMOTotalLatency     = 52,
+        OtherQueueDelay     = 53,
+        OtherMemLatency     = 54,
+        OtherTotalLatency   = 55,
+        RqstQDepth          = 56
       }MemCtrlStats;
 
       /// RevBasicMemCtrl: constructor
@@ -500,6 +585,10 @@ namespace SST {
                                     uint32_t Size, char *buffer,
                                     StandardMem::Request::flags_t flags = 0) override;
 
+      /// RevBasicMemCtrl: stage an untimed write for delivery to the memory backend during init
+      virtual bool sendUntimedWRITERequest(uint64_t Addr, uint32_t Size,
+                                           const char *buffer) override;
+
       /// RevBasicMemCtrl: send an AMO request
       virtual bool sendAMORequest(unsigned Hart, uint64_t Addr, uint64_t PAddr,
                                   uint32_t Size, char *buffer, void *target,
@@ -539,7 +628,7 @@ namespace SST {
                                           StandardMem::Request::flags_t flags) override;
 
       // RevBasicMemCtrl: send a FENCE request
-      virtual bool sendFENCE(unsigned Hart) override;
+      virtual bool sendFENCE(unsigned Hart, uint8_t Pred, uint8_t Succ) override;
 
       /// RevBasicMemCtrl: handle a read response
       virtual void handleReadResp(StandardMem::ReadResp* ev) override;
@@ -627,6 +716,48 @@ namespace SST {
       /// RevBasicMemCtrl: determine if we need to utilize RL ordering semantics
       bool isRL(unsigned Slot, unsigned Hart);
 
+      /// RevBasicMemCtrl: retrieve the FENCE access set (R and/or W) covered by the target request
+      uint8_t getFenceClass(RevMemOp *op);
+
+      /// RevBasicMemCtrl: determine if the FENCE in Slot may retire
+      bool isFenceClear(unsigned Slot);
+
+      /// RevBasicMemCtrl: determine if the request in Slot is held behind a FENCE from the same hart
+      bool isPendingFence(unsigned Slot);
+
+      /// RevBasicMemCtrl: account for a request entering or leaving flight for its hart
+      void updateHartInFlight(RevMemOp *op, int64_t Count);
+
+      /// RevBasicMemCtrl: determine if the request in Slot conflicts with an AMO on the same cache line
+      bool isAMOLineBusy(unsigned Slot);
+
+      /// RevBasicMemCtrl: determine if the target request is the READ or WRITE half of an AMO
+      bool isAMOOp(RevMemOp *op);
+
+      /// RevBasicMemCtrl: determine if the target request touches the cache line at Line
+      bool isOnAMOLine(RevMemOp *op, uint64_t Line);
+
+      /// RevBasicMemCtrl: retrieve the base address of the cache line used for AMO ordering
+      uint64_t getAMOLine(uint64_t Addr);
+
+      /// RevBasicMemCtrl: classify a demand read against the prefetched lines and train the prefetcher
+      void trainPrefetcher(RevMemOp *op);
+
+      /// RevBasicMemCtrl: issue up to Slots queued prefetches
+      void issuePrefetches(unsigned Slots);
+
+      /// RevBasicMemCtrl: track a newly issued prefetch line for usefulness statistics
+      void trackPrefetch(uint64_t Line);
+
+      /// RevBasicMemCtrl: handle the response to a prefetch request
+      void handlePrefetchResp(StandardMem::ReadResp* ev);
+
+      /// RevBasicMemCtrl: retrieve the current cycle of the controller clock
+      uint64_t getCurrentCycle();
+
+      /// RevBasicMemCtrl: record the queueing, memory and total latency of a completed request
+      void recordLatency(RevMemOp *op);
+
       /// RevBasicMemCtrl: register statistics
       void registerStats();
 
@@ -653,6 +784,7 @@ namespace SST {
       // -- private data members
       StandardMem* memIface;                  ///< StandardMem memory interface
       RevStdMemHandlers* stdMemHandlers;      ///< StandardMem interface response handlers
+      TimeConverter* timeConverter;           ///< controller clock time converter
       bool hasCache;                          ///< detects whether cache layers are present
       unsigned lineSize;                      ///< cache line size
       unsigned max_loads;                     ///< maximum number of outstanding loads
@@ -662,6 +794,7 @@ namespace SST {
       unsigned max_readlock;                  ///< maximum number of oustanding readlock events
       unsigned max_writeunlock;               ///< maximum number of oustanding writelock events
       unsigned max_custom;                    ///< maximum number of oustanding custom events
+      unsigned max_amo;                       ///< maximum number of outstanding AMO events
       unsigned max_ops;                       ///< maximum number of ops to issue per cycle
 
       uint64_t num_read;                      ///< number of outstanding read requests
@@ -671,7 +804,9 @@ namespace SST {
       uint64_t num_readlock;                  ///< number of oustanding readlock requests
       uint64_t num_writeunlock;               ///< number of oustanding writelock requests
       uint64_t num_custom;                    ///< number of outstanding custom requests
-      uint64_t num_fence;                     ///< number of oustanding fence requests
+
+      std::map<unsigned,uint64_t> HartReads;  ///< per-hart number of outstanding read-class requests
+      std::map<unsigned,uint64_t> HartWrites; ///< per-hart number of outstanding write-class requests
 
       std::vector<StandardMem::Request::id_t> requests;               ///< outstanding StandardMem requests
       std::vector<RevMemOp *> rqstQ;                                  ///< queued memory requests
@@ -691,6 +826,19 @@ namespace SST {
                    RevMemOp *,
                    bool>> AMOTable;  ///< map of amo operations to memory addresses
 
+      std::set<uint64_t> AMOLines;            ///< cache lines with an AMO in flight
+
+      RevMemPrefetcher *prefetcher;           ///< optional data prefetcher
+      unsigned max_prefetch;                  ///< maximum number of queued or outstanding prefetches
+      unsigned prefetch_track;                ///< number of prefetched lines tracked for statistics
+      std::list<uint64_t> PrefetchQ;          ///< prefetch lines awaiting issue
+      std::list<uint64_t> PrefetchOrder;      ///< tracked prefetch lines in issue order
+      std::map<uint64_t,bool> PrefetchLines;  ///< tracked prefetch lines; true once the fill returns
+      std::map<StandardMem::Request::id_t,uint64_t> PrefetchRqsts;  ///< outstanding prefetch requests
+
+      bool untimedAvail;                      ///< untimed writes are accepted until setup
+      std::vector<std::pair<uint64_t,std::vector<uint8_t>>> UntimedQ;  ///< staged untimed writes
+
       std::vector<Statistic<uint64_t>*> stats;  ///< statistics vector
 
     }; // RevBasicMemCtrl
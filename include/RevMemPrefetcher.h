@@ -0,0 +1,147 @@
+//
+// _RevMemPrefetcher_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVMEMPREFETCHER_H_
+#define _SST_REVCPU_REVMEMPREFETCHER_H_
+
+// -- C++ Headers
+#include <vector>
+#include <list>
+#include <map>
+#include <utility>
+
+// -- SST Headers
+#include <sst/core/sst_config.h>
+#include <sst/core/output.h>
+#include <sst/core/subcomponent.h>
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevMemPrefetcher
+    // ----------------------------------------
+    class RevMemPrefetcher : public SST::SubComponent {
+    public:
+
+      SST_ELI_REGISTER_SUBCOMPONENT_API(SST::RevCPU::RevMemPrefetcher)
+      SST_ELI_DOCUMENT_PARAMS({ "verbose", "Set the verbosity of output for the data prefetcher", "0" }
+      )
+
+      /// RevMemPrefetcher: default constructor
+      RevMemPrefetcher( ComponentId_t id, Params& params );
+
+      /// RevMemPrefetcher: default destructor
+      virtual ~RevMemPrefetcher();
+
+      /// RevMemPrefetcher: observe a demand read and append the cache lines to prefetch
+      virtual void Observe(unsigned Hart, uint64_t Addr, unsigned LineSize,
+                           std::vector<uint64_t> &Lines) = 0;
+
+    protected:
+      SST::Output *output;        ///< RevMemPrefetcher: sst output object
+    }; // class RevMemPrefetcher
+
+    // ----------------------------------------
+    // RevNextLinePrefetcher
+    // ----------------------------------------
+    class RevNextLinePrefetcher : public RevMemPrefetcher {
+    public:
+      SST_ELI_REGISTER_SUBCOMPONENT(RevNextLinePrefetcher, "revcpu",
+                                    "RevNextLinePrefetcher",
+                                    SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                    "RISC-V Rev next-N-line data prefetcher",
+                                    SST::RevCPU::RevMemPrefetcher
+                                    )
+
+      SST_ELI_DOCUMENT_PARAMS({ "verbose",  "Set the verbosity of output for the data prefetcher",     "0" },
+                              { "degree",   "Sets the number of lines to prefetch per demand read",    "2" },
+                              { "distance", "Sets the distance (in lines) of the first prefetched line","1" }
+      )
+
+      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS()
+
+      SST_ELI_DOCUMENT_PORTS()
+
+      SST_ELI_DOCUMENT_STATISTICS()
+
+      /// RevNextLinePrefetcher: constructor
+      RevNextLinePrefetcher( ComponentId_t id, Params& params );
+
+      /// RevNextLinePrefetcher: destructor
+      virtual ~RevNextLinePrefetcher();
+
+      /// RevNextLinePrefetcher: prefetch the lines following the demand line
+      virtual void Observe(unsigned Hart, uint64_t Addr, unsigned LineSize,
+                           std::vector<uint64_t> &Lines) override;
+
+    private:
+      unsigned degree;            ///< RevNextLinePrefetcher: lines to prefetch per demand read
+      unsigned distance;          ///< RevNextLinePrefetcher: distance of the first prefetched line
+    }; // class RevNextLinePrefetcher
+
+    // ----------------------------------------
+    // RevStridePrefetcher
+    // ----------------------------------------
+    class RevStridePrefetcher : public RevMemPrefetcher {
+    public:
+      SST_ELI_REGISTER_SUBCOMPONENT(RevStridePrefetcher, "revcpu",
+                                    "RevStridePrefetcher",
+                                    SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                    "RISC-V Rev stride data prefetcher",
+                                    SST::RevCPU::RevMemPrefetcher
+                                    )
+
+      SST_ELI_DOCUMENT_PARAMS({ "verbose",     "Set the verbosity of output for the data prefetcher",         "0" },
+                              { "table_size",  "Sets the number of stride table entries",                     "16" },
+                              { "degree",      "Sets the number of strides to prefetch once a stream is found","2" },
+                              { "distance",    "Sets the distance (in strides) of the first prefetch",        "1" },
+                              { "region_size", "Sets the size in bytes of the region tracked by each entry",  "4096" },
+                              { "confidence",  "Sets the number of matching strides required to prefetch",   "2" }
+      )
+
+      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS()
+
+      SST_ELI_DOCUMENT_PORTS()
+
+      SST_ELI_DOCUMENT_STATISTICS()
+
+      /// RevStridePrefetcher: constructor
+      RevStridePrefetcher( ComponentId_t id, Params& params );
+
+      /// RevStridePrefetcher: destructor
+      virtual ~RevStridePrefetcher();
+
+      /// RevStridePrefetcher: train the stride table and prefetch along a confirmed stride
+      virtual void Observe(unsigned Hart, uint64_t Addr, unsigned LineSize,
+                           std::vector<uint64_t> &Lines) override;
+
+    private:
+      /// RevStridePrefetcher: stride table entry
+      typedef struct{
+        uint64_t LastAddr;        ///< last demand address seen in the region
+        int64_t Stride;           ///< last observed stride
+        unsigned Confidence;      ///< number of consecutive matching strides
+      }StrideEntry;
+
+      unsigned tableSize;         ///< RevStridePrefetcher: number of table entries
+      unsigned degree;            ///< RevStridePrefetcher: strides to prefetch per demand read
+      unsigned distance;          ///< RevStridePrefetcher: distance of the first prefetch
+      uint64_t regionSize;        ///< RevStridePrefetcher: bytes tracked by each entry
+      unsigned threshold;         ///< RevStridePrefetcher: confidence required to prefetch
+
+      std::map<std::pair<unsigned,uint64_t>,StrideEntry> Table;   ///< RevStridePrefetcher: stride table
+      std::list<std::pair<unsigned,uint64_t>> LRU;                ///< RevStridePrefetcher: table replacement order
+    }; // class RevStridePrefetcher
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVMEMPREFETCHER_H_
@@ -62,6 +62,9 @@ namespace SST {
       /// RevOpts: initialize the prefetch depths
       bool InitPrefetchDepth( std::vector<std::string> Depths );
 
+      /// RevOpts: initialize the number of prefetch streams
+      bool InitPrefetchStreams( std::vector<std::string> Streams );
+
       /// RevOpts: retrieve the start address for the target core
       bool GetStartAddr( unsigned Core, uint64_t &StartAddr );
 
@@ -80,6 +83,9 @@ namespace SST {
       /// RevOpts: retrieve the prefetch depth for the target core
       bool GetPrefetchDepth( unsigned Core, unsigned &Depth );
 
+      /// RevOpts: retrieve the number of prefetch streams for the target core
+      bool GetPrefetchStreams( unsigned Core, unsigned &Streams );
+
       /// RevOpts: set the argv arrary
       void SetArgs(std::vector<std::string> A){ Argv = A; }
 
@@ -95,6 +101,7 @@ namespace SST {
       std::map<unsigned,std::string> machine;       ///< RevOpts: map of core id to machine model
       std::map<unsigned,std::string> table;         ///< RevOpts: map of core id to inst table
       std::map<unsigned,unsigned> prefetchDepth;    ///< RevOpts: map of core id to prefretch depth
+      std::map<unsigned,unsigned> prefetchStreams;  ///< RevOpts: map of core id to prefetch stream count
 
       std::vector<std::pair<unsigned,unsigned>> memCosts; ///< RevOpts: vector of memory cost ranges
 
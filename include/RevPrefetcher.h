@@ -20,20 +20,17 @@ namespace SST{
 namespace RevCPU {
 
 #define REVPREF_INIT_ADDR ((uint32_t)(0xdeadbeef))
+#define REVPREF_BTB_ENTRIES 64
 
 class RevPrefetcher{
 public:
   /// RevPrefetcher: default constructor
-  RevPrefetcher(RevMem *Mem, RevFeature *Feature, unsigned Depth)
-    : mem(Mem), feature(Feature), depth(Depth){}
+  RevPrefetcher(RevMem *Mem, RevFeature *Feature, unsigned Depth, unsigned Streams);
 
   /// RevPrefetcher: default destructor
   ~RevPrefetcher(){
-    // delete all the existing streams
-    baseAddr.clear();
-    for( unsigned i=0; i<iStack.size(); i++ ){
-      delete [] iStack[i];
-    }
+    delete [] iStack;
+    delete [] iHazard;
   }
 
   /// RevPrefetcher: fetch the next instruction
@@ -42,19 +39,70 @@ public:
   /// RevPrefetcher: determines in the target instruction is already cached in a stream
   bool IsAvail(uint64_t Addr);
 
+  /// RevPrefetcher: determines whether the target instruction only waits on an issued fill
+  bool IsWaiting(uint64_t Addr);
+
 private:
+  /// RevPrefetcher: stream slot
+  typedef struct{
+    uint64_t Base;                            ///< base address of the stream window
+    uint64_t LastUse;                         ///< access stamp used for LRU replacement
+    unsigned Start;                           ///< first filled instruction slot in the window
+    bool Valid;                               ///< slot holds a stream
+  }StreamSlot;
+
+  /// RevPrefetcher: branch target buffer entry
+  typedef struct{
+    uint64_t PC;                              ///< address of the branch
+    uint64_t Target;                          ///< last observed taken target
+    bool Valid;                               ///< entry is valid
+  }BTBEntry;
+
   RevMem *mem;                                ///< RevMem object
   RevFeature *feature;                        ///< RevFeature object
   unsigned depth;                             ///< Depth of each prefetcher stream
-  std::vector<uint64_t> baseAddr;             ///< Vector of base addresses for each stream
-  std::vector<uint32_t*> iStack;              ///< Vector of instruction vectors
-  std::vector<bool*> iHazard;                 ///< Vector of instruction cost vectors
+  unsigned streams;                           ///< Number of preallocated stream slots
+  uint64_t window;                            ///< Bytes covered by each stream (depth*4)
+  unsigned hashMask;                          ///< Mask applied to the stream hash
+  uint64_t Stamp;                             ///< Monotonic access counter
+  std::vector<StreamSlot> slots;              ///< Stream slots
+  std::vector<int> hashIdx;                   ///< Stream hash to slot index (-1 when empty)
+  uint32_t *iStack;                           ///< Instruction payloads [streams x depth]
+  bool *iHazard;                              ///< Outstanding fill hazards [streams x depth]
+  BTBEntry btb[REVPREF_BTB_ENTRIES];          ///< Branch target buffer
+  uint64_t lastPC;                            ///< Address of the last fetched instruction
+  unsigned lastSize;                          ///< Size of the last fetched instruction
+  bool lastBranch;                            ///< Last fetched instruction was a jal/branch
+
+  /// hashes a stream window base address
+  unsigned Hash(uint64_t Base){
+    uint64_t W = Base / window;
+    return (unsigned)((W ^ (W >> 7)) & hashMask);
+  }
+
+  /// finds the stream holding the address; returns -1 on a miss
+  int FindStream(uint64_t Addr, unsigned &Off);
+
+  /// determines whether the target slot has outstanding fills
+  bool IsBusy(unsigned Slot);
 
   /// fills a missed stream cache instruction
   void Fill(uint64_t Addr);
 
-  /// deletes the target stream buffer
-  void DeleteStream(unsigned i);
+  /// fills the stream holding the address if it is not already resident
+  void Prefetch(uint64_t Addr);
+
+  /// issues line-sized reads for instruction slots [First,Last) of a stream
+  void FillRange(unsigned Slot, unsigned First, unsigned Last);
+
+  /// aligns a stream instruction slot down to the start of its cache line
+  unsigned LineStart(unsigned Slot, unsigned Off);
+
+  /// trains the branch target buffer and prefetches known targets
+  void Train(uint64_t Addr, uint32_t Inst);
+
+  /// determines whether the instruction is a jal or conditional branch
+  bool IsBranch(uint32_t Inst);
 
   /// attempts to fetch the upper half of a 32bit word of an unaligned base address
   bool FetchUpper(uint64_t Addr, bool &Fetched, uint32_t &UInst);
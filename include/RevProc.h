@@ -28,6 +28,7 @@
 #include <functional>
 #include <tuple>
 #include <list>
+#include <set>
 #include <inttypes.h>
 
 // -- RevCPU Headers
@@ -37,13 +38,18 @@
 #include "RevLoader.h"
 #include "RevInstTable.h"
 #include "RevInstTables.h"
+#include "RevInstTableRegistry.h"
 #include "PanExec.h"
 #include "RevPrefetcher.h"
 #include "RevCoProc.h"
 #include "RevThreadCtx.h"
+#include "RevThreadSched.h"
 #include "../common/syscalls/SysFlags.h"
 
 #define _PAN_FWARE_JUMP_            0x0000000000010000
+#define _REV_FF_MARKER_IMM_         0x1   ///< "addi x0, x0, 1" ends fast-forward
+#define _REV_BULK_INFLIGHT_         32    ///< line reads a bulk syscall copy keeps in flight under memHierarchy
+#define _REV_BULK_CHUNK_            65536 ///< bytes a bulk syscall copy stages on the host at a time
 
 using namespace SST::RevCPU;
 
@@ -62,6 +68,17 @@ namespace SST{
       /// RevProc: per-processor clock function
       bool ClockTick( SST::Cycle_t currentCycle );
 
+      /// RevProc: determines whether every following cycle only waits on an outstanding memory response
+      bool IsMemoryBlocked();
+
+      /// RevProc: account the idle statistics of cycles skipped while blocked on memory
+      void AccountIdle( uint64_t Cycles );
+
+      /// RevProc: functionally execute up to Count instructions with no timing model;
+      ///          returns true if StopPC or the marker instruction was reached
+      bool FastForward( uint64_t Count, uint64_t StopPC, bool UntilMarker,
+                        uint64_t &Executed );
+
       /// RevProc: halt the CPU
       bool Halt();
 
@@ -86,6 +103,33 @@ namespace SST{
       /// RevProc: Set the PAN execution context
       void SetExecCtx(PanExec *P) { PExec = P; }
 
+      /// RevProc: place cloned threads through a scheduler shared by all cores; idle cores wait for one
+      void SetThreadSched(RevThreadSched *S, bool StartIdle) { Sched = S; SchedIdle = StartIdle; }
+
+      /// RevProc: set the modeled cost of syscalls that copy guest buffers
+      void SetSyscallCost(uint64_t Latency, uint64_t BytesPerCycle) { SyscallLatency = Latency; SyscallBPC = BytesPerCycle; }
+
+      /// RevProc: stop fetching new instructions so that the pipeline drains
+      void SetDrain(bool Drain) { Draining = Drain; }
+
+      /// RevProc: determines whether the core has no in-flight instructions or memory requests
+      bool IsQuiescent() { return Pipeline.empty() && !PendingCtxSwitch && !mem->outstandingRqsts(); }
+
+      /// RevProc: retrieve the number of retired instructions
+      uint64_t GetRetired() { return Retired; }
+
+      /// RevProc: write the architectural state (thread table, active pids) to a checkpoint
+      bool DumpState(std::ostream &os);
+
+      /// RevProc: restore the architectural state from a checkpoint
+      bool RestoreState(const char *Buf, size_t Len, size_t &Off, std::set<int> &Reopened);
+
+      /// RevProc: resolves a register file address to its owning PID and byte offset
+      bool ResolveRegTarget(uint64_t *Target, uint32_t &PID, uint64_t &Offset);
+
+      /// RevProc: rebuilds a register file address from its owning PID and byte offset
+      uint64_t *RebuildRegTarget(uint32_t PID, uint64_t Offset);
+
       /// RevProc: Retrieve a random memory cost value
       unsigned RandCost() { return mem->RandCost(feature->GetMinCost(),feature->GetMaxCost()); }
 
@@ -124,6 +168,10 @@ namespace SST{
       /// RevProc: Create a new RevThreadCtx w/ Parent is currently executing thread
       uint32_t CreateChildCtx();
 
+      /// RevProc: Clone the executing thread per the Linux clone flags and schedule the child; returns the child's PID
+      uint32_t CloneCtx(uint64_t Flags, uint64_t NewSP, uint64_t ParentTID,
+                        uint64_t TLS, uint64_t ChildTID);
+
       /// RevProc: Get the ThreadState of a thread (pid) from the ThreadTable (Unused)
       ThreadState GetThreadState(uint32_t pid);
 
@@ -186,6 +234,14 @@ namespace SST{
       uint64_t Retired;         ///< RevProc: number of retired instructions
       bool PendingCtxSwitch = false; ///< RevProc: determines if the core is halted
       bool SwapToParent = false; ///< RevProc: determines if the core is halted
+      bool Draining = false;    ///< RevProc: fetch is suspended while the pipeline drains
+      bool BlockedFetch = false; ///< RevProc: the memory block is an instruction fetch (vs. a load hazard)
+      RevThreadSched *Sched = nullptr; ///< RevProc: cross-core guest thread scheduler (null when threads are pinned)
+      bool SchedIdle = false;   ///< RevProc: no scheduled thread is loaded on the core
+      uint64_t SliceCycles = 0; ///< RevProc: cycles the loaded thread has run since it was scheduled
+      uint64_t SchedCycle = 0;  ///< RevProc: component cycle of the current tick; futex deadlines are measured against it
+      std::bitset<_REV_HART_COUNT_> HART_CTS; ///< RevProc: Thread is clear to start (proceed with decode)
+      std::bitset<_REV_HART_COUNT_> HART_CTE; ///< RevProc: Thread is clear to execute (no register dependencides)
       uint32_t NextPID = 0;
 
       RevOpts *opts;            ///< RevProc: options object
@@ -214,10 +270,27 @@ namespace SST{
         ERROR = 255
      }ECALL_status_t;
 
-     // TODO: We may need one of these per HART
-     char* ECALL_buf;
-     std::string ECALL_string;
-     uint32_t ECALL_bytesRead;
+     /// RevProc: progress of the ecall on HartToExec; owned by the bound thread so it survives a switch
+     RevSyscallState& SyscallState() { return HartCtx[HartToExec]->GetSyscallState(); }
+
+     uint64_t SyscallLatency = 0;                ///< RevProc: fixed cycles charged once to a syscall that copies guest buffers
+     uint64_t SyscallBPC = 8;                    ///< RevProc: bytes per cycle charged to an untimed bulk copy (0 is free)
+
+     /// RevProc: gather Len guest bytes at Addr into the ecall's BulkBuf; returns false while the copy is in flight
+     bool BulkRead(RevInst& inst, uint64_t Addr, size_t Len);
+
+     /// RevProc: scatter Len bytes into guest memory at Addr; returns false if the copy is timed by memHierarchy
+     bool BulkWrite(uint64_t Addr, const char *Data, size_t Len);
+
+     /// RevProc: charge the modeled bandwidth of a bulk syscall copy to the ecall
+     void ChargeBulk(RevInst& inst, size_t Len, bool Untimed);
+
+     /// RevProc: charge the fixed syscall latency to the ecall; called once per syscall
+     void ChargeSyscall(RevInst& inst);
+
+     /// RevProc: read/readv/pread64/preadv into guest memory; Vec reads Count iovecs at Buf, Pos < 0 uses the file offset
+     ECALL_status_t ReadIntoGuest(RevInst& inst, int fd, uint64_t Buf,
+                                  uint64_t Count, bool Vec, int64_t Pos);
 
       ECALL_status_t ECALL_io_setup(RevInst& inst);               // 0, rev_io_setup(unsigned nr_reqs, aio_context_t  *ctx)
       ECALL_status_t ECALL_io_destroy(RevInst& inst);             // 1, rev_io_destroy(aio_context_t ctx)
@@ -549,11 +622,15 @@ namespace SST{
       /// RevProc: Vector of PIDs where index of ActivePIDs is the pid of the RevThreadCtx loaded into Hart #Idx
       std::vector<uint32_t> ActivePIDs;
 
-      RevInst Inst;             ///< RevProc: instruction payload
+      std::shared_ptr<RevThreadCtx> HartCtx[_REV_HART_COUNT_];  ///< RevProc: RevThreadCtx bound to each Hart
+      RevRegFile *HartRegs[_REV_HART_COUNT_] = {};              ///< RevProc: register file of the RevThreadCtx bound to each Hart
 
-      std::vector<RevInstEntry> InstTable;        ///< RevProc: target instruction table
+      /// RevProc: Bind a RevThreadCtx to a Hart; ThreadTable is only searched when a context switches, never per cycle
+      void BindHart(uint16_t HartID, std::shared_ptr<RevThreadCtx> Ctx);
 
-      std::vector<RevExt *> Extensions;           ///< RevProc: vector of enabled extensions
+      RevInst Inst;             ///< RevProc: instruction payload
+
+      std::shared_ptr<const RevInstTableSet> ITab;  ///< RevProc: instruction tables shared with like-configured cores
 
 #define PIPE_HART     0
 #define PIPE_INST     1
@@ -562,14 +639,6 @@ namespace SST{
       std::vector<std::pair<uint16_t,RevInst>> Pipeline;  ///< RevProc: pipeline of instructions
       std::list<bool *> LoadHazards;                      ///< RevProc: list of allocated load hazards
 
-      std::map<std::string,unsigned> NameToEntry; ///< RevProc: instruction mnemonic to table entry mapping
-      std::map<uint32_t,unsigned> EncToEntry;     ///< RevProc: instruction encoding to table entry mapping
-      std::map<uint32_t,unsigned> CEncToEntry;    ///< RevProc: compressed instruction encoding to table entry mapping
-
-      std::map<unsigned,std::pair<unsigned,unsigned>> EntryToExt;     ///< RevProc: instruction entry to extension object mapping
-                                                                      ///           first = Master table entry number
-                                                                      ///           second = pair<Extension Index, Extension Entry>
-
       /// RevProc: creates a new pipeline load hazard and returns a pointer to it
       bool *createLoadHazard();
 
@@ -586,16 +655,16 @@ namespace SST{
       bool LoadInstructionTable();
 
       /// RevProc: see the instruction table the target features
-      bool SeedInstTable();
+      bool SeedInstTable(RevInstTableSet &T);
 
       /// RevProc: enable the target extension by merging its instruction table with the master
-      bool EnableExt(RevExt *Ext, bool Opt);
+      bool EnableExt(RevInstTableSet &T, RevExt *Ext, bool Opt);
 
       /// RevProc: initializes the internal mapping tables
-      bool InitTableMapping();
+      bool InitTableMapping(RevInstTableSet &T);
 
       /// RevProc: read in the user defined cost tables
-      bool ReadOverrideTables();
+      bool ReadOverrideTables(RevInstTableSet &T, const std::string &Table);
 
       /// RevProc: compresses the encoding structure to a single value
       uint32_t CompressEncoding(RevInstEntry Entry);
@@ -696,6 +765,15 @@ namespace SST{
       /// RevProc: Clear scoreboard on instruction retirement
       void DependencyClear(uint16_t threadID, uint16_t RegNum, bool isFloat);
 
+      /// RevProc: retire, load or preempt scheduled threads; returns false if the core has no thread to run
+      bool SchedTick( SST::Cycle_t currentCycle );
+
+      /// RevProc: load a scheduled thread onto the core in place of the current one
+      void LoadThread(std::shared_ptr<RevThreadCtx> Ctx);
+
+      /// RevProc: mark the loaded thread complete and release the core
+      void RetireThread();
+
     }; // class RevProc
   } // namespace RevCPU
 } // namespace SST
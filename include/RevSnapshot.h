@@ -0,0 +1,89 @@
+//
+// _RevSnapshot_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVSNAPSHOT_H_
+#define _SST_REVCPU_REVSNAPSHOT_H_
+
+// -- C++ Headers
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <ostream>
+
+#define _REVSNAP_MAGIC_   0x50414e5356455200ull   ///< "\0REVSNAP"
+#define _REVSNAP_VERSION_ 1
+#define _REVCKPT_MAGIC_   0x54504b4356455200ull   ///< "\0REVCKPT"
+#define _REVCKPT_VERSION_ 2
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevSnapshot
+    // ----------------------------------------
+    // Helpers for the post-load memory image snapshots written by
+    // RevLoader and RevMem and the architectural checkpoints written
+    // by RevCPU.  Values are stored in host byte order;
+    // snapshots are not portable across hosts of differing endianness.
+    class RevSnapshot {
+    public:
+      /// RevSnapshot: write a scalar value
+      template <typename T>
+      static void Put( std::ostream &os, const T &Val ){
+        os.write((const char *)(&Val), sizeof(T));
+      }
+
+      /// RevSnapshot: write a length-prefixed string
+      static void PutStr( std::ostream &os, const std::string &Str ){
+        Put<uint64_t>(os, (uint64_t)(Str.size()));
+        os.write(Str.data(), Str.size());
+      }
+
+      /// RevSnapshot: read a scalar value; returns false if the buffer is exhausted
+      template <typename T>
+      static bool Get( const char *Buf, size_t Len, size_t &Off, T &Val ){
+        if( (Len < sizeof(T)) || (Off > (Len - sizeof(T))) )
+          return false;
+        std::memcpy(&Val, &Buf[Off], sizeof(T));
+        Off += sizeof(T);
+        return true;
+      }
+
+      /// RevSnapshot: read a length-prefixed string; returns false if the buffer is exhausted
+      static bool GetStr( const char *Buf, size_t Len, size_t &Off, std::string &Str ){
+        uint64_t Size = 0;
+        if( !Get<uint64_t>(Buf, Len, Off, Size) || (Size > (Len - Off)) )
+          return false;
+        Str.assign(&Buf[Off], Size);
+        Off += Size;
+        return true;
+      }
+
+      /// RevSnapshot: fold a buffer into a 64bit FNV-1a style hash
+      static uint64_t Hash( uint64_t H, const char *Buf, size_t Len ){
+        // hash eight bytes at a time; multi-hundred MB binaries are common
+        size_t i = 0;
+        for( ; (i+8) <= Len; i += 8 ){
+          uint64_t W;
+          std::memcpy(&W, &Buf[i], sizeof(W));
+          H = (H ^ W) * 0x100000001b3ull;
+        }
+        for( ; i < Len; i++ ){
+          H = (H ^ (uint8_t)(Buf[i])) * 0x100000001b3ull;
+        }
+        return H;
+      }
+    }; // class RevSnapshot
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVSNAPSHOT_H_
@@ -15,6 +15,10 @@
 // -- Standard Headers
 #include <cstdint>
 #include <vector>
+#include <set>
+#include <string>
+#include <memory>
+#include <ostream>
 
 // -- Rev Headers
 #include "../include/RevMem.h"
@@ -28,6 +32,39 @@ enum class ThreadState {
   Dead,
 };
 
+/// RevSyscallState: Progress of the (multi-pass) ecall a thread is executing
+struct RevSyscallState {
+  char Buf[64] = {};                        /// Scratch for fixed-size values read from guest memory
+  std::string String;                       /// Guest string gathered one character per pass
+  uint32_t BytesRead = 0;                   /// Progress through the current ecall (0 when idle)
+
+  std::vector<char> BulkBuf;                /// Guest buffer gathered by a bulk syscall copy
+  std::unique_ptr<bool[]> BulkHazard;       /// Per-line hazards of a bulk copy through memHierarchy
+  bool BulkActive = false;                  /// A bulk copy is in flight
+  size_t BulkLines = 0;                     /// Line reads making up the bulk copy
+  size_t BulkIssued = 0;                    /// Line reads issued so far
+  size_t BulkDone = 0;                      /// Line reads completed, in order
+  uint64_t BulkOff = 0;                     /// Buffer offset of the next line read
+  uint64_t BulkProgress = 0;                /// Bytes of a chunked bulk syscall already completed
+
+  bool FutexBlocked = false;                /// The thread parks on FutexAddr once its futex wait retires
+  uint64_t FutexAddr = 0;                   /// Futex word of the pending wait
+  uint64_t FutexSeqNo = 0;                  /// Wake sequence sampled before the futex word was read
+  uint32_t FutexBitset = 0;                 /// FUTEX_WAIT_BITSET mask of the pending wait
+  uint64_t FutexDeadline = 0;               /// Component cycle at which the pending wait times out (0 never)
+
+  /// RevSyscallState: Drop the progress of the current ecall
+  void Clear(){
+    Buf[0] = '\0';
+    String.clear();
+    BytesRead = 0;
+    BulkHazard.reset();
+    BulkActive = false;
+    BulkProgress = 0;
+    FutexBlocked = false;
+  }
+};
+
 class RevThreadCtx {
 
 private:
@@ -37,6 +74,8 @@ private:
   RevRegFile RegFile;                       /// Each context has its own register file
   std::vector<uint32_t> ChildrenPIDs = {};  /// List of a thread's children (unused)
   std::vector<int> fildes = {0, 1, 2};      /// Initial fildes are STDOUT, STDIN, and STDERR 
+  uint64_t ClearTID = 0;                    /// Guest address zeroed when the thread exits (CLONE_CHILD_CLEARTID)
+  RevSyscallState Syscall;                  /// In-progress ecall; travels with the thread between harts
 
 public:
   // Constructor that takes a RevRegFile object and a uint32_t ParentPID
@@ -51,7 +90,7 @@ public:
 
   bool DuplicateRegFile(RevRegFile& regToDup);    /// RevThreadCtx: Makes its own register file a copy of regToDup
   RevRegFile* GetRegFile() { return &RegFile; }   /// RevThreadCtx: Returns pointer to its register file
-  void SetRegFile(RevRegFile r) { RegFile = r; }  /// RevThreadCtx: Sets pointer to its register file
+  void SetRegFile(const RevRegFile &r) { RegFile = r; } /// RevThreadCtx: Overwrites its register file with r
 
   uint32_t GetPID() { return PID; }               /// RevThreadCtx: Gets Ctx's PID
   void SetPID(uint32_t NewPID) { PID = NewPID; }  /// RevThreadCtx: Sets Ctx's PID
@@ -59,6 +98,11 @@ public:
   uint32_t GetParentPID() const { return ParentPID; }                /// RevThreadCtx: Gets Ctx's Parent's PID
   void SetParentPID(uint32_t parent_pid) { ParentPID = parent_pid; } /// RevThreadCtx: Gets Ctx's PID
 
+  uint64_t GetClearTID() const { return ClearTID; }                  /// RevThreadCtx: Gets the address zeroed on exit
+  void SetClearTID(uint64_t Addr) { ClearTID = Addr; }               /// RevThreadCtx: Sets the address zeroed on exit
+
+  RevSyscallState& GetSyscallState() { return Syscall; }            /// RevThreadCtx: Returns the state of the ecall in progress
+
   ThreadState GetState() const { return State; }                     /// RevThreadCtx: Returns the state (ThreadState) of this Ctx
   void SetState(ThreadState newState) { State = newState; }          /// RevThreadCtx: Used to change ThreadState of this Ctx
 
@@ -69,6 +113,10 @@ public:
   bool isWaiting(){ return (State == ThreadState::Waiting); }        /// RevThreadCtx: Checks if Ctx's ThreadState is Running
   bool isDead(){ return (State == ThreadState::Dead); }              /// RevThreadCtx: Checks if Ctx's ThreadState is Running
 
+  bool DumpCtx(std::ostream &os);                                    /// RevThreadCtx: Writes the Ctx (registers, children, open fildes) to a checkpoint
+  bool RestoreCtx(const char *Buf, size_t Len, size_t &Off,
+                  std::set<int> &Reopened);                          /// RevThreadCtx: Restores the Ctx from a checkpoint; host fds are reopened once
+
 };
 
 
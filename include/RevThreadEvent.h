@@ -0,0 +1,87 @@
+//
+// _RevThreadEvent_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTHREADEVENT_H_
+#define _SST_REVCPU_REVTHREADEVENT_H_
+
+// -- C++ Headers
+#include <cstdint>
+#include <vector>
+
+// -- SST Headers
+#include <sst/core/sst_config.h>
+#include <sst/core/event.h>
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevThreadEvent
+    // ----------------------------------------
+    // Carries a guest thread between RevCPU components that share a
+    // memory backend.  A Spawn event holds the thread context as
+    // written by RevThreadCtx::DumpCtx; a Release event tells the
+    // receiver that no further threads will arrive.
+    class RevThreadEvent : public SST::Event {
+    public:
+      /// RevThreadEvent: event kinds
+      typedef enum{
+        Spawn   = 0,                ///< RevThreadEvent: run the enclosed thread context
+        Release = 1                 ///< RevThreadEvent: the sender will export no more threads
+      }EventKind;
+
+      /// RevThreadEvent: standard constructor
+      RevThreadEvent(uint8_t kind, uint32_t rank)
+        : Event(), Kind(kind), SrcRank(rank) { }
+
+      /// RevThreadEvent: extended constructor
+      RevThreadEvent(uint8_t kind, uint32_t rank, std::vector<char> ctx)
+        : Event(), Kind(kind), SrcRank(rank), Ctx(ctx) { }
+
+      /// RevThreadEvent: retrieve the event kind
+      uint8_t getKind() { return Kind; }
+
+      /// RevThreadEvent: retrieve the memRank of the sender
+      uint32_t getSrcRank() { return SrcRank; }
+
+      /// RevThreadEvent: retrieve the serialized thread context
+      const std::vector<char>& getCtx() { return Ctx; }
+
+      /// RevThreadEvent: virtual function to clone an event
+      virtual Event* clone(void) override{
+        RevThreadEvent* ev = new RevThreadEvent(*this);
+        return ev;
+      }
+
+    private:
+      uint8_t Kind;                 ///< RevThreadEvent: EventKind
+      uint32_t SrcRank;             ///< RevThreadEvent: memRank of the sending component
+      std::vector<char> Ctx;        ///< RevThreadEvent: serialized thread context
+
+    public:
+      /// RevThreadEvent: secondary constructor
+      RevThreadEvent() : Event() {}
+
+      /// RevThreadEvent: event serializer
+      void serialize_order(SST::Core::Serialization::serializer &ser) override{
+        Event::serialize_order(ser);
+        ser & Kind;
+        ser & SrcRank;
+        ser & Ctx;
+      }
+
+      /// RevThreadEvent: implements the event serialization
+      ImplementSerializable(SST::RevCPU::RevThreadEvent);
+    };  // end RevThreadEvent
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVTHREADEVENT_H_
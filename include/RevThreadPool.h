@@ -0,0 +1,64 @@
+//
+// _RevThreadPool_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTHREADPOOL_H_
+#define _SST_REVCPU_REVTHREADPOOL_H_
+
+// -- C++ Headers
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevThreadPool
+    // ----------------------------------------
+    // Persistent host threads used by RevCPU to clock its cores in
+    // parallel.  Run() hands the same job to every thread (the calling
+    // thread acts as thread 0) and returns once all of them finish,
+    // which forms the barrier at the end of each quantum.
+    class RevThreadPool {
+    public:
+      /// RevThreadPool: constructor; spawns Threads-1 worker threads
+      RevThreadPool( unsigned Threads );
+
+      /// RevThreadPool: destructor; joins the worker threads
+      ~RevThreadPool();
+
+      /// RevThreadPool: retrieve the number of threads, including the caller
+      unsigned GetThreads() { return numThreads; }
+
+      /// RevThreadPool: run Job(ThreadIdx) on every thread and wait for all of them
+      void Run( const std::function<void(unsigned)> &Job );
+
+    private:
+      unsigned numThreads;                            ///< RevThreadPool: threads including the caller
+      std::vector<std::thread> workers;               ///< RevThreadPool: worker threads [1..numThreads)
+      std::mutex mtx;                                 ///< RevThreadPool: guards the job handoff
+      std::condition_variable startCV;                ///< RevThreadPool: signals a new job
+      std::condition_variable doneCV;                 ///< RevThreadPool: signals job completion
+      const std::function<void(unsigned)> *job;       ///< RevThreadPool: current job
+      uint64_t generation;                            ///< RevThreadPool: job sequence number
+      unsigned pending;                               ///< RevThreadPool: workers still running the job
+      bool shutdown;                                  ///< RevThreadPool: workers should exit
+
+      /// RevThreadPool: worker thread body
+      void Worker( unsigned Idx );
+    }; // class RevThreadPool
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVTHREADPOOL_H_
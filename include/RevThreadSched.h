@@ -0,0 +1,155 @@
+//
+// _RevThreadSched_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTHREADSCHED_H_
+#define _SST_REVCPU_REVTHREADSCHED_H_
+
+// -- C++ Headers
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// -- Rev Headers
+#include "RevThreadCtx.h"
+
+#define _REV_FUTEX_SEQ_BUCKETS_ 256   ///< RevThreadSched: wake sequence counters shared by hashed futex words
+
+namespace SST {
+  namespace RevCPU {
+
+    // ----------------------------------------
+    // RevThreadSched
+    // ----------------------------------------
+    // Places the guest threads created by clone on the cores of a
+    // RevCPU.  Every core owns a run queue; with stealing enabled new
+    // threads are queued on the creating core and idle cores take the
+    // oldest thread from the longest queue, otherwise new threads are
+    // queued on the least loaded core.  Threads blocked in futex wait
+    // are parked on per-address wait queues until woken or timed out.
+    // Components sharing a memory backend may hand new threads to one
+    // another through an export hook; a component whose main thread
+    // never runs waits for them until released.
+    // All methods are safe to call from cores clocked on host threads.
+    class RevThreadSched {
+    public:
+      /// RevThreadSched: constructor
+      RevThreadSched( unsigned NumCores, uint64_t Quantum, bool Steal,
+                      uint64_t CyclePS );
+
+      /// RevThreadSched: queue a newly created thread, unless the export hook hands it to another component
+      void Spawn( unsigned Core, std::shared_ptr<RevThreadCtx> Ctx );
+
+      /// RevThreadSched: set the hook offered every new thread; it returns true if it took the thread
+      void SetExport( std::function<bool(std::shared_ptr<RevThreadCtx>)> Fn ) { exportFn = Fn; }
+
+      /// RevThreadSched: the main thread never runs here; stay alive for threads from other components
+      void AwaitRemote();
+
+      /// RevThreadSched: no further threads will arrive from other components
+      void Release();
+
+      /// RevThreadSched: requeue a preempted thread on its core
+      void Yield( unsigned Core, std::shared_ptr<RevThreadCtx> Ctx );
+
+      /// RevThreadSched: retrieve the next thread for the core; returns nullptr if none is runnable
+      std::shared_ptr<RevThreadCtx> Next( unsigned Core );
+
+      /// RevThreadSched: record the completion of a thread
+      void Exit();
+
+      /// RevThreadSched: determines whether any thread is waiting for a core
+      bool HasWaiting();
+
+      /// RevThreadSched: determines whether every thread has completed
+      bool Done();
+
+      /// RevThreadSched: determines whether a single thread has yet to complete
+      bool IsLast();
+
+      /// RevThreadSched: retrieve the wake sequence of a futex word; sampled before a waiter reads the word
+      uint64_t FutexSeq( uint64_t Addr );
+
+      /// RevThreadSched: park a thread on a futex word; returns false if a wake raced past the sampled sequence
+      bool FutexPark( uint64_t Addr, uint64_t Seq, uint32_t Bitset,
+                      uint64_t Deadline, std::shared_ptr<RevThreadCtx> Ctx );
+
+      /// RevThreadSched: wake up to Count threads parked on a futex word; returns the number woken
+      unsigned FutexWake( unsigned Core, uint64_t Addr, unsigned Count, uint32_t Bitset );
+
+      /// RevThreadSched: requeue the parked threads whose deadline (in component cycles) has passed
+      void FutexExpire( unsigned Core, uint64_t Now );
+
+      /// RevThreadSched: determines whether every live thread is parked without a deadline
+      bool Deadlocked();
+
+      /// RevThreadSched: convert a guest timeout in nanoseconds to cycles
+      uint64_t ToCycles( uint64_t Ns ) { return ((Ns*1000) + cyclePS - 1) / cyclePS; }
+
+      /// RevThreadSched: retrieve the preemption quantum in cycles (0 disables preemption)
+      uint64_t GetQuantum() { return quantum; }
+
+      /// RevThreadSched: retrieve the number of threads created
+      uint64_t GetSpawned() { return spawned; }
+
+      /// RevThreadSched: retrieve the number of threads stolen by idle cores
+      uint64_t GetSteals() { return steals; }
+
+      /// RevThreadSched: retrieve the number of preempted threads
+      uint64_t GetPreemptions() { return preemptions; }
+
+    private:
+      /// RevThreadSched: a thread parked on a futex word
+      typedef struct{
+        std::shared_ptr<RevThreadCtx> Ctx;                          ///< parked thread
+        uint32_t Bitset;                                            ///< FUTEX_WAIT_BITSET mask
+        uint64_t Deadline;                                          ///< timeout in component cycles (0 waits forever)
+      }FutexWaiter;
+
+      /// RevThreadSched: the threads parked on a futex word; erased once empty
+      typedef struct{
+        std::deque<FutexWaiter> Waiters;                            ///< parked threads in arrival order
+      }FutexQueue;
+
+      /// RevThreadSched: select the wake sequence bucket of a futex word
+      uint64_t &SeqOf( uint64_t Addr ) { return futexSeq[(Addr >> 2) % futexSeq.size()]; }
+
+      /// RevThreadSched: select the run queue for a new or woken thread
+      unsigned Place( unsigned Core );
+
+      /// RevThreadSched: queue a woken thread; the caller holds the lock
+      void Ready( unsigned Core, std::shared_ptr<RevThreadCtx> Ctx );
+
+      uint64_t quantum;                                             ///< RevThreadSched: cycles before a thread may be preempted
+      bool steal;                                                   ///< RevThreadSched: idle cores steal from busy ones
+      std::vector<std::deque<std::shared_ptr<RevThreadCtx>>> runQ;  ///< RevThreadSched: per-core run queues
+      std::mutex mtx;                                               ///< RevThreadSched: guards the run queues and counters
+      uint64_t live;                                                ///< RevThreadSched: threads that have not completed
+      uint64_t waiting;                                             ///< RevThreadSched: threads sitting in a run queue
+      uint64_t spawned;                                             ///< RevThreadSched: threads created
+      uint64_t steals;                                              ///< RevThreadSched: threads taken from another core's queue
+      uint64_t preemptions;                                         ///< RevThreadSched: threads requeued after their quantum
+      uint64_t cyclePS;                                             ///< RevThreadSched: core clock period in picoseconds
+      uint64_t parked;                                              ///< RevThreadSched: threads parked on futex words
+      std::unordered_map<uint64_t, FutexQueue> futex;               ///< RevThreadSched: futex wait queues by guest address
+      std::vector<uint64_t> futexSeq;                               ///< RevThreadSched: wakes issued per address bucket
+      std::atomic<uint64_t> nextDeadline;                           ///< RevThreadSched: earliest futex deadline (UINT64_MAX if none)
+      std::function<bool(std::shared_ptr<RevThreadCtx>)> exportFn;  ///< RevThreadSched: hands new threads to other components
+      bool awaiting;                                                ///< RevThreadSched: threads may still arrive from other components
+    }; // class RevThreadSched
+
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVTHREADSCHED_H_
@@ -32,9 +32,11 @@ namespace SST{
                 (uint32_t *)(&R->RV64[Inst.rd]),
                 Inst.aq, Inst.rl, Inst.hazard,
                 REVMEM_FLAGS(RevCPU::RevFlag::F_SEXT64));
+          R->RV64[Inst.rd] = R->RV64[Inst.rd] & 0xFFFFFFFF;
+          SEXT(R->RV64[Inst.rd], R->RV64[Inst.rd], 32);
           R->RV64_PC += Inst.instSize;
         }
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -52,6 +54,7 @@ namespace SST{
                 (uint32_t *)(&R->RV64[Inst.rd]),
                 Inst.aq, Inst.rl,
                 REVMEM_FLAGS(RevCPU::RevFlag::F_SEXT64));
+          R->RV64[Inst.rd] = R->RV64[Inst.rd] & 0xFFFFFFFF;
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -89,7 +92,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -125,7 +128,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -161,7 +164,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -197,7 +200,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -233,7 +236,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -269,7 +272,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -305,7 +308,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -341,7 +344,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -377,7 +380,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -91,7 +91,7 @@ namespace SST{
             R->RV64_PC += Inst.instSize;
           }
         }
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
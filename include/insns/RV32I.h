@@ -462,7 +462,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -487,7 +487,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -512,7 +512,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -537,7 +537,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -562,7 +562,7 @@ namespace SST{
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -872,7 +872,10 @@ namespace SST{
       }
 
       static bool fence(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        M->FenceMem(F->GetHart());
+        // imm[7:4] = predecessor set (PI,PO,PR,PW); imm[3:0] = successor set (SI,SO,SR,SW)
+        M->FenceMem(F->GetHart(),
+                    (uint8_t)((Inst.imm >> 4) & 0xF),
+                    (uint8_t)(Inst.imm & 0xF));
         if( F->IsRV32() ){
           R->RV32_PC += Inst.instSize;
         }else{
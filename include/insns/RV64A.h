@@ -64,7 +64,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -90,7 +90,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -116,7 +116,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -142,7 +142,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -168,7 +168,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -194,7 +194,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -220,7 +220,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -246,7 +246,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
@@ -272,7 +272,7 @@ namespace SST{
          R->RV64_PC += Inst.instSize;
 
         // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
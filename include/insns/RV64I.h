@@ -99,7 +99,7 @@ namespace SST{
         R->RV64[Inst.rd] = 0x00ULL;
         R->RV64[Inst.rd] |= (uint64_t)(val);
         //ZEXT64(R->RV64[Inst.rd], (uint64_t)val, 64);
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         R->RV64_PC += Inst.instSize;
         return true;
       }
@@ -110,7 +110,7 @@ namespace SST{
                     &R->RV64[Inst.rd],
                     Inst.hazard,
                     REVMEM_FLAGS(0x00));
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
+        R->cost += M->MemCost(F->GetHart(),F->GetMinCost(),F->GetMaxCost());
         R->RV64_PC += Inst.instSize;
         return true;
       }
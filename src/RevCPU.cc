@@ -10,6 +10,9 @@
 
 #include "../include/RevCPU.h"
 #include <cmath>
+#include <set>
+#include <fstream>
+#include <sstream>
 
 const char *splash_msg = "\
 \n\
@@ -35,6 +38,12 @@ const char *pan_splash_msg = "\
 RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
   : SST::Component(id), testStage(0), PrivTag(0), address(-1), PrevAddr(_PAN_RDMA_MAILBOX_),
     EnableNIC(false), EnablePAN(false), EnablePANStats(false), EnableMemH(false),
+    EnableL1(false), Quantum(1), Pool(nullptr), Sched(nullptr),
+    MemRank(0), MemRanks(1), Exported(0), RemoteReleased(false), EnableSuspend(false), Suspended(false),
+    SuspendCycle(0), ClockHandler(nullptr), CkptCycle(0), CkptInst(0), CkptExit(false),
+    CkptPending(false), CkptDone(false),
+    SampleState(SampleOff), SampleFunc(0), SampleWarm(0), SampleDetail(0),
+    SampleMark(0), SampleStart(0), SampleInsts(0),
     ReadyForRevoke(false), Nic(nullptr), PNic(nullptr), PExec(nullptr), Ctrl(nullptr) {
 
   const int Verbosity = params.find<int>("verbose", 0);
@@ -53,8 +62,23 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
                                      new SST::Clock::Handler<RevCPU>(this,&RevCPU::clockTickPANTest));
       testIters = params.find<unsigned>("testIters", 255);
     }else{
-      timeConverter  = registerClock(cpuClock,
-                                     new SST::Clock::Handler<RevCPU>(this,&RevCPU::clockTick));
+      // standalone runs may advance several core cycles per callback;
+      // memHierarchy and PAN traffic must be clocked every cycle
+      Quantum = params.find<unsigned>("quantum", 1);
+      if( Quantum == 0 )
+        Quantum = 1;
+      if( (Quantum > 1) &&
+          (params.find<bool>("enable_memH", 0) || params.find<bool>("enable_pan", 0)) ){
+        output.verbose(CALL_INFO, 1, 0,
+                       "Warning: quantum requires enable_memH=0 and enable_pan=0; using 1\n");
+        Quantum = 1;
+      }
+      UnitAlgebra Period(cpuClock);
+      if( Period.hasUnits("Hz") )
+        Period.invert();
+      Period *= (uint64_t)(Quantum);
+      ClockHandler   = new SST::Clock::Handler<RevCPU>(this,&RevCPU::clockTick);
+      timeConverter  = registerClock(Period, ClockHandler);
     }
   }
 
@@ -112,6 +136,11 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     params.find_array<std::string>("prefetchDepth",prefetchDepths);
     if( !Opts->InitPrefetchDepth( prefetchDepths) )
       output.fatal(CALL_INFO, -1, "Error: failed to initalize the prefetch depth\n" );
+
+    std::vector<std::string> prefetchStreams;
+    params.find_array<std::string>("prefetchStreams",prefetchStreams);
+    if( !Opts->InitPrefetchStreams( prefetchStreams ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initalize the prefetch streams\n" );
   }
 
   // See if we should load the network interface controller
@@ -192,7 +221,17 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
   // Create the memory object
   const unsigned long memSize = params.find<unsigned long>("memSize", 1073741824);
   EnableMemH = params.find<bool>("enable_memH", 0);
+
+  // several RevCPU components (possibly on different ranks) may share one
+  // memHierarchy backend and guest address space
+  MemRanks = params.find<unsigned>("memRanks", 1);
+  MemRank  = params.find<unsigned>("memRank", 0);
+  if( MemRank >= MemRanks )
+    output.fatal(CALL_INFO, -1, "Error: memRank=%u must be less than memRanks=%u\n", MemRank, MemRanks );
+
   if( !EnableMemH ){
+    if( MemRanks > 1 )
+      output.fatal(CALL_INFO, -1, "Error: memRanks requires a shared memHierarchy backend (enable_memH=1)\n" );
     Mem = new RevMem( memSize, Opts,  &output );
     if( !Mem )
       output.fatal(CALL_INFO, -1, "Error: failed to initialize the memory object\n" );
@@ -208,6 +247,24 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     if( !Mem )
       output.fatal(CALL_INFO, -1, "Error : failed to initialize the memory object\n" );
 
+    // stage the program image, arguments and stack as untimed writes
+    // that are delivered to the memory backend during init
+    Mem->SetPreload(params.find<bool>("enable_preload", 1));
+
+    // only the first component delivers the program image and runs
+    // main; the others load the binary for its symbols and segments,
+    // hand out disjoint PIDs and run the threads main clones
+    if( MemRanks > 1 ){
+      if( !params.find<bool>("enable_preload", 1) )
+        output.fatal(CALL_INFO, -1, "Error: memRanks requires enable_preload=1\n" );
+      if( !params.find<bool>("threadSched", 0) )
+        output.fatal(CALL_INFO, -1, "Error: memRanks requires threadSched=1\n" );
+      Mem->SetImageOwner(MemRank == 0);
+      Mem->OffsetPIDs(MemRank * _REVMEM_RANK_PIDS_);
+      output.verbose(CALL_INFO, 1, 0, "Sharing the memory backend as rank %u of %u\n",
+                     MemRank, MemRanks);
+    }
+
     if( EnableFaults )
       output.verbose(CALL_INFO, 1, 0, "Warning: memory faults cannot be enabled with memHierarchy support\n");
   }
@@ -220,14 +277,46 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
   const unsigned long maxHeapSize = params.find<unsigned long>("maxHeapSize", std::floor((memSize/4)));
   Mem->SetMaxHeapSize(maxHeapSize);
 
-  // Load the binary into memory
-  Loader = new RevLoader( Exe, Args, Mem, &output );
+  // Load the binary into memory, or restore it from a post-load snapshot
+  Loader = new RevLoader( Exe, Args, Mem, &output,
+                          params.find<std::string>("snapshot", "") );
   if( !Loader ){
     output.fatal(CALL_INFO, -1, "Error: failed to initialize the RISC-V loader\n" );
   }
 
   Opts->SetArgs(Loader->GetArgv());
 
+  // give each component sharing the backend its own slice of the heap
+  // and its own stack below the one holding the program arguments
+  if( MemRanks > 1 ){
+    Mem->PartitionHeap(MemRank, MemRanks);
+    Mem->PartitionStack(MemRank, MemRanks);
+  }
+
+  // Attach the internal L1 cache model once the binary is loaded
+  // so that the loader's writes do not warm the cache
+  EnableL1 = params.find<bool>("enable_l1", 0);
+  if( EnableL1 ){
+    if( EnableMemH ){
+      output.verbose(CALL_INFO, 1, 0,
+                     "Warning: the internal L1 cache model is ignored with memHierarchy\n");
+      EnableL1 = false;
+    }else{
+      RevL1Cache *L1 = new RevL1Cache( params.find<uint64_t>("l1Size", 32768),
+                                       params.find<unsigned>("l1Ways", 8),
+                                       params.find<unsigned>("l1LineSize", 64),
+                                       params.find<unsigned>("l1HitLatency", 1),
+                                       params.find<unsigned>("l1MissLatency", 10),
+                                       params.find<bool>("l1WriteBack", 1),
+                                       params.find<bool>("l1WriteAllocate", 1),
+                                       &output );
+      Mem->SetL1Cache(L1);
+      L1Hits = registerStatistic<uint64_t>("L1Hits");
+      L1Misses = registerStatistic<uint64_t>("L1Misses");
+      L1Writebacks = registerStatistic<uint64_t>("L1Writebacks");
+    }
+  }
+
   EnableCoProc = params.find<bool>("enableCoProc", 0);
   if(EnableCoProc){
     // Create the co-processor objects
@@ -251,6 +340,15 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     }
   }
 
+  // modeled cost of syscalls that copy guest buffers
+  {
+    const uint64_t SyscallLatency = params.find<uint64_t>("syscallLatency", 0);
+    const uint64_t SyscallBandwidth = params.find<uint64_t>("syscallBandwidth", 8);
+    for( unsigned i=0; i<Procs.size(); i++ ){
+      Procs[i]->SetSyscallCost(SyscallLatency, SyscallBandwidth);
+    }
+  }
+
   // setup the per-proc statistics
   TotalCycles.reserve(TotalCycles.size() + numCores);
   CyclesWithIssue.reserve(CyclesWithIssue.size() + numCores);
@@ -296,6 +394,121 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     Enabled[i] = true;
   }
 
+  // Setup the guest thread scheduler; core 0 runs main and the
+  // remaining cores wait for the threads it clones
+  if( params.find<bool>("threadSched", 0) ){
+    if( EnablePAN || EnablePANTest )
+      output.fatal(CALL_INFO, -1, "Error: threadSched cannot be combined with PAN\n" );
+    if( !params.find<std::string>("checkpoint", "").empty() ||
+        !params.find<std::string>("restore", "").empty() ||
+        !params.find<std::string>("fastForward", "").empty() ||
+        (params.find<uint64_t>("sampleFunctional", 0) > 0) )
+      output.fatal(CALL_INFO, -1, "Error: threadSched cannot be combined with checkpoints, fast-forward or sampling\n" );
+    // futex timeouts are converted to core cycles
+    UnitAlgebra CyclePeriod(params.find<std::string>("clock", "1GHz"));
+    if( CyclePeriod.hasUnits("Hz") )
+      CyclePeriod.invert();
+    Sched = new RevThreadSched( numCores,
+                                params.find<uint64_t>("threadQuantum", 0),
+                                params.find<bool>("threadSteal", 1),
+                                (uint64_t)((CyclePeriod / UnitAlgebra("1ps")).getRoundedValue()) );
+    for( unsigned i=0; i<Procs.size(); i++ ){
+      Procs[i]->SetThreadSched(Sched, (i != 0) || (MemRank != 0));
+    }
+
+    // components sharing a memory backend pass cloned threads over
+    // links: the first one exports them round-robin, the others start
+    // idle and run what they are sent until it releases them
+    if( MemRanks > 1 ){
+      SchedLinks.resize(MemRanks, nullptr);
+      for( unsigned r=0; r<MemRanks; r++ ){
+        if( (r == MemRank) || ((MemRank != 0) && (r != 0)) )
+          continue;
+        SchedLinks[r] = configureLink("sched_" + std::to_string(r), "1ns",
+                                      new Event::Handler<RevCPU>(this, &RevCPU::handleThreadEvent));
+        if( !SchedLinks[r] )
+          output.fatal(CALL_INFO, -1, "Error: memRank %u is not linked to memRank %u (port sched_%u)\n",
+                       MemRank, r, r );
+      }
+      if( MemRank == 0 ){
+        Sched->SetExport([this](std::shared_ptr<RevThreadCtx> Ctx){ return ExportThread(Ctx); });
+      }else{
+        Sched->AwaitRemote();
+      }
+    }
+    ThreadsSpawned = registerStatistic<uint64_t>("ThreadsSpawned");
+    ThreadSteals = registerStatistic<uint64_t>("ThreadSteals");
+    ThreadPreemptions = registerStatistic<uint64_t>("ThreadPreemptions");
+  }
+
+  // Setup the architectural checkpoints
+  CkptFile  = params.find<std::string>("checkpoint", "");
+  CkptCycle = params.find<uint64_t>("checkpointCycle", 0);
+  CkptInst  = params.find<uint64_t>("checkpointInst", 0);
+  CkptExit  = params.find<bool>("checkpointExit", 0);
+  if( !CkptFile.empty() ){
+    if( EnableMemH )
+      output.fatal(CALL_INFO, -1, "Error: checkpoints require the internal memory model (enable_memH=0)\n" );
+    if( (CkptCycle == 0) && (CkptInst == 0) )
+      output.fatal(CALL_INFO, -1, "Error: checkpoint requires checkpointCycle or checkpointInst\n" );
+  }
+
+  {
+    const std::string Restore = params.find<std::string>("restore", "");
+    if( !Restore.empty() && !RestoreCheckpoint(Restore) )
+      output.fatal(CALL_INFO, -1, "Error: failed to restore checkpoint %s\n", Restore.c_str() );
+  }
+
+  // Skip the uninteresting prologue without the timing model
+  {
+    const std::string FF = params.find<std::string>("fastForward", "");
+    if( !FF.empty() )
+      FastForward(FF);
+  }
+
+  // Setup the sampled simulation windows
+  SampleFunc   = params.find<uint64_t>("sampleFunctional", 0);
+  SampleWarm   = params.find<uint64_t>("sampleWarmup", 0);
+  SampleDetail = params.find<uint64_t>("sampleDetailed", 0);
+  if( SampleFunc > 0 ){
+    if( EnableMemH )
+      output.fatal(CALL_INFO, -1, "Error: sampling requires the internal memory model (enable_memH=0)\n" );
+    if( SampleDetail == 0 )
+      output.fatal(CALL_INFO, -1, "Error: sampleFunctional requires sampleDetailed\n" );
+    if( !CkptFile.empty() )
+      output.fatal(CALL_INFO, -1, "Error: sampling and checkpoint cannot be combined\n" );
+    SampleState = SampleDrain;
+    SampleWindows = registerStatistic<uint64_t>("SampleWindows");
+    SampledInsts = registerStatistic<uint64_t>("SampledInsts");
+    EstimatedCycles = registerStatistic<uint64_t>("EstimatedCycles");
+  }
+
+  // Setup the host thread pool; the cores only share RevMem, so
+  // memHierarchy, PAN, co-processors and fault injection stay serial
+  {
+    unsigned Threads = std::min(params.find<unsigned>("threads", 1), numCores);
+    if( (Threads > 1) &&
+        (EnableMemH || EnablePAN || EnablePANTest || EnableCoProc || EnableFaults) ){
+      output.verbose(CALL_INFO, 1, 0,
+                     "Warning: threads requires enable_memH=0, enable_pan=0, enableCoProc=0 and enable_faults=0; using 1\n");
+      Threads = 1;
+    }
+    if( Threads > 1 ){
+      Mem->SetThreadSafe(true);
+      Pool = new RevThreadPool(Threads);
+      Finished.resize(numCores, 0);
+      output.verbose(CALL_INFO, 1, 0, "Clocking %u cores on %u host threads\n",
+                     numCores, Threads);
+    }
+  }
+
+  // Suspend the clock while every core waits on memHierarchy; the
+  // memory controller wakes us when the next response is delivered
+  EnableSuspend = params.find<bool>("enable_suspend", 1) && EnableMemH &&
+    !EnablePAN && !EnablePANTest && !EnableCoProc && !EnableFaults && Ctrl;
+  if( EnableSuspend )
+    Ctrl->setResponseNotify([this](){ WakeClock(); });
+
   {
     const unsigned Splash = params.find<bool>("splash",0);
 
@@ -316,6 +529,10 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
 
 RevCPU::~RevCPU(){
 
+  // stop the host threads before the cores go away
+  if( Pool )
+    delete Pool;
+
   // delete the competion array
   delete[] Enabled;
 
@@ -324,6 +541,10 @@ RevCPU::~RevCPU(){
     delete Procs[i];
   }
 
+  // the queued guest threads are released with the scheduler
+  if( Sched )
+    delete Sched;
+
   for (unsigned i=0; i<CoProcs.size(); i++){
     delete CoProcs[i];
   }
@@ -511,6 +732,46 @@ void RevCPU::setup(){
 }
 
 void RevCPU::finish(){
+  if( SampleState != SampleOff ){
+    // extrapolate the whole-program CPI from the detailed windows
+    size_t N = SampleCPI.size();
+    double Mean = 0.0, Var = 0.0, CI = 0.0;
+    for( auto C : SampleCPI ){
+      Mean += C;
+    }
+    if( N > 0 )
+      Mean /= (double)(N);
+    for( auto C : SampleCPI ){
+      Var += (C-Mean)*(C-Mean);
+    }
+    if( N > 1 ){
+      Var /= (double)(N-1);
+      CI = 1.96*std::sqrt(Var/(double)(N));
+    }
+    uint64_t Est = (uint64_t)(Mean*(double)(RetiredInsts()));
+    SampleWindows->addData(N);
+    SampledInsts->addData(SampleInsts);
+    EstimatedCycles->addData(Est);
+    output.verbose(CALL_INFO, 1, 0,
+                   "Sampled CPI: %f +/- %f (95%% confidence, %zu windows); estimated cycles=%" PRIu64 "\n",
+                   Mean, CI, N, Est);
+  }
+
+  if( Sched ){
+    ThreadsSpawned->addData(Sched->GetSpawned());
+    ThreadSteals->addData(Sched->GetSteals());
+    ThreadPreemptions->addData(Sched->GetPreemptions());
+  }
+
+  if( EnableL1 ){
+    RevL1Cache *L1 = Mem->GetL1Cache();
+    L1Hits->addData(L1->GetHits());
+    L1Misses->addData(L1->GetMisses());
+    L1Writebacks->addData(L1->GetWritebacks());
+    output.verbose(CALL_INFO, 2, 0,
+                   "L1 cache: hits=%" PRIu64 " misses=%" PRIu64 " writebacks=%" PRIu64 "\n",
+                   L1->GetHits(), L1->GetMisses(), L1->GetWritebacks());
+  }
 }
 
 void RevCPU::init( unsigned int phase ){
@@ -2366,30 +2627,356 @@ void RevCPU::UpdateCoreStatistics(uint16_t coreNum){
   TLBMissesPerCore[coreNum]->addData(stats.memStats.TLBMisses);
 }
 
-bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
-  bool rtn = true;
+void RevCPU::FastForward(const std::string& Spec){
+  if( EnableMemH )
+    output.fatal(CALL_INFO, -1, "Error: fastForward requires the internal memory model (enable_memH=0)\n" );
+
+  uint64_t Limit  = UINT64_MAX;
+  uint64_t StopPC = UINT64_MAX;   // never a valid PC
+  bool Marker     = false;
+  if( Spec == "marker" ){
+    Marker = true;
+  }else if( Spec.rfind("sym:", 0) == 0 ){
+    StopPC = Loader->GetSymbolAddr(Spec.substr(4));
+    if( StopPC == 0x00ull )
+      output.fatal(CALL_INFO, -1, "Error: fastForward symbol %s not found\n", Spec.substr(4).c_str() );
+  }else{
+    char *End = nullptr;
+    Limit = strtoull(Spec.c_str(), &End, 0);
+    if( (End == Spec.c_str()) || (*End != '\0') )
+      output.fatal(CALL_INFO, -1, "Error: malformed fastForward value %s\n", Spec.c_str() );
+  }
 
-  output.verbose(CALL_INFO, 8, 0, "Cycle: %" PRIu64 "\n", static_cast<uint64_t>(currentCycle));
+  uint64_t Total = FastForwardCores(Limit, StopPC, Marker);
+  output.verbose(CALL_INFO, 1, 0, "Fast-forwarded %" PRIu64 " instructions\n", Total);
+  for( unsigned i=0; i<Procs.size(); i++ ){
+    if( Enabled[i] )
+      output.verbose(CALL_INFO, 1, 0, "Core %u resumes timed execution at PC=0x%" PRIx64 "\n",
+                     i, Procs[i]->GetPC());
+  }
+}
 
-  // Execute each enabled core
+uint64_t RevCPU::FastForwardCores(uint64_t Limit, uint64_t StopPC, bool Marker){
+  // rotate through the cores in quanta so that cores communicating
+  // through shared memory make progress; the first core to reach the
+  // stop point ends fast-forward for all of them
+  uint64_t Total = 0;
+  bool Done = false;
+  while( !Done ){
+    bool Progress = false;
+    for( unsigned i=0; (i<Procs.size()) && !Done; i++ ){
+      if( !Enabled[i] )
+        continue;
+      uint64_t Quantum = std::min((uint64_t)(_REV_FF_QUANTUM_), Limit - Total);
+      uint64_t Executed = 0;
+      if( Quantum == 0 || Procs[i]->FastForward(Quantum, StopPC, Marker, Executed) )
+        Done = true;
+      Total += Executed;
+      Progress |= (Executed != 0);
+    }
+    // every core finished or is waiting on the timed path
+    if( !Progress )
+      Done = true;
+  }
+  return Total;
+}
+
+uint64_t RevCPU::RetiredInsts(){
+  uint64_t Retired = 0;
+  for( auto P : Procs ){
+    Retired += P->GetRetired();
+  }
+  return Retired;
+}
+
+bool RevCPU::AllQuiescent(){
   for( unsigned i=0; i<Procs.size(); i++ ){
-    if( Enabled[i] ){
-      if( !Procs[i]->ClockTick(currentCycle) ){
-         if(EnableCoProc && !CoProcs.empty()){
-          CoProcs[i]->Teardown();
-         }
-         UpdateCoreStatistics(i);
+    if( Enabled[i] && !Procs[i]->IsQuiescent() )
+      return false;
+  }
+  return true;
+}
+
+void RevCPU::SampleTick(SST::Cycle_t currentCycle){
+  switch( SampleState ){
+  case SampleDrain:
+    if( !AllQuiescent() )
+      return ;
+    // the pipelines are empty; start the functional period
+    [[fallthrough]];
+  case SampleFunctional:
+    FastForwardCores(SampleFunc, UINT64_MAX, false);
+    for( auto P : Procs ){
+      P->SetDrain(false);
+    }
+    SampleMark = RetiredInsts();
+    SampleStart = currentCycle;
+    SampleState = (SampleWarm > 0) ? SampleWarmup : SampleDetailed;
+    break;
+  case SampleWarmup:
+    // warm-up runs timed but is not measured
+    if( (RetiredInsts() - SampleMark) >= SampleWarm ){
+      SampleMark = RetiredInsts();
+      SampleStart = currentCycle;
+      SampleState = SampleDetailed;
+    }
+    break;
+  case SampleDetailed:
+    {
+      uint64_t Insts = RetiredInsts() - SampleMark;
+      if( Insts >= SampleDetail ){
+        SampleCPI.push_back((double)(currentCycle - SampleStart)/(double)(Insts));
+        SampleInsts += Insts;
+        SampleState = SampleDrain;
+        for( auto P : Procs ){
+          P->SetDrain(true);
+        }
+      }
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+bool RevCPU::RestoreCheckpoint(const std::string& File){
+  int fd = open(File.c_str(), O_RDONLY);
+  if( fd < 0 )
+    return false;
+  struct stat FileStats;
+  if( (fstat(fd,&FileStats) < 0) || (FileStats.st_size == 0) ){
+    close(fd);
+    return false;
+  }
+
+  size_t Len = FileStats.st_size;
+  char *Buf = (char *)(mmap(NULL, Len, PROT_READ, MAP_PRIVATE, fd, 0));
+  close(fd);
+  if( Buf == MAP_FAILED )
+    return false;
+
+  // reject checkpoints of a different binary, argument list or core count
+  size_t Off = 0;
+  uint64_t Magic = 0, Key = 0, Cycle = 0;
+  uint32_t Version = 0, NumCores = 0;
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Magic) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, Version) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Key) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, NumCores) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Cycle) ||
+      (Magic != _REVCKPT_MAGIC_) || (Version != _REVCKPT_VERSION_) ||
+      (Key != Loader->SnapshotKey()) || (NumCores != Procs.size()) ){
+    output.verbose(CALL_INFO, 1, 0, "Checkpoint %s does not match this configuration\n",
+                   File.c_str());
+    munmap( Buf, Len );
+    return false;
+  }
+
+  if( !Mem->RestoreImage(Buf, Len, Off) ){
+    munmap( Buf, Len );
+    return false;
+  }
+
+  // from here on the state has been replaced; any failure is fatal
+  bool Ok = true;
+  std::set<int> Reopened;
+  for( unsigned i=0; Ok && (i<Procs.size()); i++ ){
+    uint8_t En = 0;
+    Ok = RevSnapshot::Get<uint8_t>(Buf, Len, Off, En) &&
+         Procs[i]->RestoreState(Buf, Len, Off, Reopened);
+    Enabled[i] = (En != 0);
+  }
+  Ok = Ok && Mem->RestoreReservations(Buf, Len, Off,
+                                      [this](uint32_t PID, uint64_t Offset) -> uint64_t* {
+                                        for( auto P : Procs ){
+                                          uint64_t *Target = P->RebuildRegTarget(PID, Offset);
+                                          if( Target != nullptr )
+                                            return Target;
+                                        }
+                                        return nullptr;
+                                      });
+  munmap( Buf, Len );
+
+  if( !Ok )
+    output.fatal(CALL_INFO, -1, "Error: checkpoint %s is corrupt\n", File.c_str() );
+
+  output.verbose(CALL_INFO, 1, 0, "Restored checkpoint %s taken at cycle %" PRIu64 "\n",
+                 File.c_str(), Cycle);
+  return true;
+}
+
+bool RevCPU::WriteCheckpoint(SST::Cycle_t currentCycle){
+  // write to a private file and rename it so that a crash never
+  // leaves a partial checkpoint behind
+  std::string Tmp = CkptFile + "." + std::to_string(getpid());
+  std::ofstream os(Tmp, std::ios::binary | std::ios::trunc);
+  if( !os.is_open() )
+    return false;
+
+  RevSnapshot::Put<uint64_t>(os, _REVCKPT_MAGIC_);
+  RevSnapshot::Put<uint32_t>(os, _REVCKPT_VERSION_);
+  RevSnapshot::Put<uint64_t>(os, Loader->SnapshotKey());
+  RevSnapshot::Put<uint32_t>(os, (uint32_t)(Procs.size()));
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(currentCycle));
+
+  bool Ok = Mem->DumpImage(os);
+  for( unsigned i=0; Ok && (i<Procs.size()); i++ ){
+    RevSnapshot::Put<uint8_t>(os, (uint8_t)(Enabled[i]));
+    Ok = Procs[i]->DumpState(os);
+  }
+  Ok = Ok && Mem->DumpReservations(os,
+                                   [this](uint64_t *Target, uint32_t &PID, uint64_t &Offset){
+                                     for( auto P : Procs ){
+                                       if( P->ResolveRegTarget(Target, PID, Offset) )
+                                         return true;
+                                     }
+                                     return false;
+                                   });
+
+  os.close();
+  if( !Ok || os.fail() || (rename(Tmp.c_str(), CkptFile.c_str()) != 0) ){
+    unlink(Tmp.c_str());
+    return false;
+  }
+
+  output.verbose(CALL_INFO, 1, 0, "Wrote checkpoint %s at cycle %" PRIu64 "\n",
+                 CkptFile.c_str(), static_cast<uint64_t>(currentCycle));
+  return true;
+}
+
+bool RevCPU::CheckpointTick(SST::Cycle_t currentCycle){
+  if( CkptFile.empty() || CkptDone )
+    return false;
+
+  if( !CkptPending ){
+    if( !((CkptCycle && (currentCycle >= CkptCycle)) ||
+          (CkptInst && (RetiredInsts() >= CkptInst))) )
+      return false;
+
+    // stop fetching and let the in-flight instructions retire
+    CkptPending = true;
+    for( auto P : Procs ){
+      P->SetDrain(true);
+    }
+  }
+
+  if( !AllQuiescent() )
+    return false;
+
+  if( !WriteCheckpoint(currentCycle) )
+    output.fatal(CALL_INFO, -1, "Error: failed to write checkpoint %s\n", CkptFile.c_str() );
+
+  CkptPending = false;
+  CkptDone = true;
+  for( auto P : Procs ){
+    P->SetDrain(false);
+  }
+  return CkptExit;
+}
+
+void RevCPU::ClockCoresParallel( SST::Cycle_t currentCycle ){
+  const SST::Cycle_t Base = currentCycle*Quantum;
+
+  // global triggers are evaluated at quantum boundaries
+  if( SampleState != SampleOff )
+    SampleTick(Base);
+  if( CheckpointTick(Base) ){
+    for( unsigned i=0; i<Procs.size(); i++ ){
+      if( Enabled[i] ){
+        UpdateCoreStatistics(i);
         Enabled[i] = false;
+      }
+    }
+  }
+
+  // each host thread clocks an interleaved slice of the cores
+  // through the whole quantum; returning from Run is the barrier
+  Pool->Run([this,Base](unsigned T){
+    for( unsigned i=T; i<Procs.size(); i+=Pool->GetThreads() ){
+      if( !Enabled[i] )
+        continue;
+      for( unsigned q=0; q<Quantum; q++ ){
+        if( !Procs[i]->ClockTick(Base+q) ){
+          Finished[i] = 1;
+          break;
+        }
+      }
+    }
+  });
+
+  // retire the completed cores on the simulation thread
+  for( unsigned i=0; i<Procs.size(); i++ ){
+    if( Finished[i] ){
+      Finished[i] = 0;
+      UpdateCoreStatistics(i);
+      Enabled[i] = false;
       output.verbose(CALL_INFO, 5, 0, "Closing Processor %d at Cycle: %" PRIu64 "\n",
-                     i, static_cast<uint64_t>(currentCycle));
+                     i, static_cast<uint64_t>(Base));
+    }
+  }
+}
+
+bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
+  bool rtn = true;
+
+  output.verbose(CALL_INFO, 8, 0, "Cycle: %" PRIu64 "\n", static_cast<uint64_t>(currentCycle));
+
+  // advance the cores by a full quantum of core cycles
+  if( Pool ){
+    ClockCoresParallel(currentCycle);
+  }else{
+    for( unsigned q=0; q<Quantum; q++ ){
+      const SST::Cycle_t Cycle = (currentCycle*Quantum)+q;
+
+      // alternate between functional and detailed sampling windows
+      if( SampleState != SampleOff )
+        SampleTick(Cycle);
+
+      // drive the checkpoint drain; stop every core if we exit afterwards
+      if( CheckpointTick(Cycle) ){
+        for( unsigned i=0; i<Procs.size(); i++ ){
+          if( Enabled[i] ){
+            UpdateCoreStatistics(i);
+            Enabled[i] = false;
+          }
+        }
       }
-      if(EnableCoProc && !CoProcs[i]->ClockTick(currentCycle)){
-      output.verbose(CALL_INFO, 5, 0, "Closing Co-Processor %d at Cycle: %" PRIu64 "\n",
-                     i, static_cast<uint64_t>(currentCycle));
 
+      // Execute each enabled core
+      for( unsigned i=0; i<Procs.size(); i++ ){
+        if( Enabled[i] ){
+          if( !Procs[i]->ClockTick(Cycle) ){
+             if(EnableCoProc && !CoProcs.empty()){
+              CoProcs[i]->Teardown();
+             }
+             UpdateCoreStatistics(i);
+            Enabled[i] = false;
+          output.verbose(CALL_INFO, 5, 0, "Closing Processor %d at Cycle: %" PRIu64 "\n",
+                         i, static_cast<uint64_t>(Cycle));
+          }
+          if(EnableCoProc && !CoProcs[i]->ClockTick(Cycle)){
+          output.verbose(CALL_INFO, 5, 0, "Closing Co-Processor %d at Cycle: %" PRIu64 "\n",
+                         i, static_cast<uint64_t>(Cycle));
+
+          }
+        }
+      }
+
+      // check to see if we need to inject a fault
+      if( EnableFaults ){
+        if( FaultCntr == 0 ){
+          // inject a fault
+          HandleFaultInjection(Cycle);
+
+          // reset the fault counter
+          FaultCntr = fault_width;
+        }else{
+          FaultCntr--;
+        }
       }
     }
   }
+
   // Clock the PAN network transport module
   if( EnablePAN ){
 
@@ -2414,19 +3001,6 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
       output.fatal(CALL_INFO, -1, "Error: failed to process the PAN zero address put queue\n" );
   }
 
-  // check to see if we need to inject a fault
-  if( EnableFaults ){
-    if( FaultCntr == 0 ){
-      // inject a fault
-      HandleFaultInjection(currentCycle);
-
-      // reset the fault counter
-      FaultCntr = fault_width;
-    }else{
-      FaultCntr--;
-    }
-  }
-
   // check to see if all the processors are completed
   for( unsigned i=0; i<Procs.size(); i++ ){
     if( Enabled[i] )
@@ -2452,11 +3026,98 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
   }
 
   if( rtn ){
+    ReleaseRemotes();
     primaryComponentOKToEndSim();
     output.verbose(CALL_INFO, 5, 0, "OK to end sim at cycle: %" PRIu64 "\n", static_cast<uint64_t>(currentCycle));
+  }else if( EnableSuspend && AllMemoryBlocked() ){
+    // nothing can change until memory responds; drop off the clock
+    output.verbose(CALL_INFO, 8, 0, "Suspending at cycle: %" PRIu64 "\n", static_cast<uint64_t>(currentCycle));
+    Suspended = true;
+    SuspendCycle = currentCycle;
+    rtn = true;
   }
 
   return rtn;
 }
 
+bool RevCPU::AllMemoryBlocked(){
+  bool Any = false;
+  for( unsigned i=0; i<Procs.size(); i++ ){
+    if( !Enabled[i] )
+      continue;
+    if( !Procs[i]->IsMemoryBlocked() )
+      return false;
+    Any = true;
+  }
+  return Any;
+}
+
+void RevCPU::WakeClock(){
+  if( !Suspended )
+    return ;
+  Suspended = false;
+
+  // the cores would have spent every skipped cycle waiting
+  SST::Cycle_t Next = reregisterClock(timeConverter, ClockHandler);
+  uint64_t Skipped = (Next > (SuspendCycle+1)) ? (Next - SuspendCycle - 1) : 0;
+  for( unsigned i=0; i<Procs.size(); i++ ){
+    if( Enabled[i] )
+      Procs[i]->AccountIdle(Skipped);
+  }
+  output.verbose(CALL_INFO, 8, 0, "Resuming at cycle %" PRIu64 " after %" PRIu64 " idle cycles\n",
+                 static_cast<uint64_t>(Next), Skipped);
+}
+
+bool RevCPU::ExportThread(std::shared_ptr<RevThreadCtx> Ctx){
+  // new threads are dealt round-robin over the components, starting
+  // with the next one, so every MemRanks-th thread stays here
+  const unsigned Target = (unsigned)((++Exported) % MemRanks);
+  if( Target == MemRank )
+    return false;
+
+  std::ostringstream os;
+  if( !Ctx->DumpCtx(os) )
+    output.fatal(CALL_INFO, -1, "Error: failed to serialize thread %u\n", Ctx->GetPID() );
+  const std::string Buf = os.str();
+  SchedLinks[Target]->send(new RevThreadEvent(RevThreadEvent::Spawn, MemRank,
+                                              std::vector<char>(Buf.begin(), Buf.end())));
+  output.verbose(CALL_INFO, 2, 0, "Sending thread %u to memRank %u\n",
+                 Ctx->GetPID(), Target);
+  return true;
+}
+
+void RevCPU::ReleaseRemotes(){
+  if( (MemRank != 0) || RemoteReleased )
+    return ;
+  RemoteReleased = true;
+  for( unsigned r=1; r<MemRanks; r++ ){
+    SchedLinks[r]->send(new RevThreadEvent(RevThreadEvent::Release, MemRank));
+  }
+}
+
+void RevCPU::handleThreadEvent(SST::Event *ev){
+  RevThreadEvent *event = static_cast<RevThreadEvent*>(ev);
+
+  if( event->getKind() == RevThreadEvent::Release ){
+    output.verbose(CALL_INFO, 2, 0, "Released by memRank %u\n", event->getSrcRank());
+    Sched->Release();
+  }else{
+    // the thread keeps its PID, registers and clear-on-exit address;
+    // its stores and loads reach the backend it shares with the sender
+    const std::vector<char>& Buf = event->getCtx();
+    auto Ctx = std::make_shared<RevThreadCtx>(0, 0);
+    std::set<int> Reopened;
+    size_t Off = 0;
+    if( !Ctx->RestoreCtx(Buf.data(), Buf.size(), Off, Reopened) )
+      output.fatal(CALL_INFO, -1, "Error: malformed thread from memRank %u\n", event->getSrcRank() );
+    Sched->Spawn(0, Ctx);
+    output.verbose(CALL_INFO, 1, 0, "memRank %u adopted thread %u from memRank %u\n",
+                   MemRank, Ctx->GetPID(), event->getSrcRank());
+  }
+  delete event;
+
+  // an idle component may have dropped off the clock
+  WakeClock();
+}
+
 // EOF
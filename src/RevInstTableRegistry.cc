@@ -0,0 +1,36 @@
+//
+// _RevInstTableRegistry_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevInstTableRegistry.h"
+
+using namespace SST;
+using namespace RevCPU;
+
+std::mutex RevInstTableRegistry::Lock;
+std::map<std::string,std::shared_ptr<const RevInstTableSet>> RevInstTableRegistry::Sets;
+
+std::shared_ptr<const RevInstTableSet> RevInstTableRegistry::Find( const std::string& Machine,
+                                                                   const std::string& Table ){
+  std::lock_guard<std::mutex> Guard(Lock);
+  auto it = Sets.find(Key(Machine,Table));
+  if( it == Sets.end() )
+    return nullptr;
+  return it->second;
+}
+
+std::shared_ptr<const RevInstTableSet> RevInstTableRegistry::Insert( const std::string& Machine,
+                                                                     const std::string& Table,
+                                                                     std::shared_ptr<const RevInstTableSet> Set ){
+  std::lock_guard<std::mutex> Guard(Lock);
+  auto it = Sets.insert(std::make_pair(Key(Machine,Table),Set));
+  return it.first->second;
+}
+
+// EOF
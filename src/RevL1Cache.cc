@@ -0,0 +1,113 @@
+//
+// _RevL1Cache_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevL1Cache.h"
+
+using namespace SST;
+using namespace RevCPU;
+
+RevL1Cache::RevL1Cache( uint64_t Size, unsigned Ways, unsigned LineSize,
+                        unsigned HitLatency, unsigned MissLatency,
+                        bool WriteBack, bool WriteAllocate,
+                        SST::Output *Output )
+  : numSets(0), ways(Ways), lineSize(LineSize), hitLatency(HitLatency),
+    missLatency(MissLatency), writeBack(WriteBack),
+    writeAllocate(WriteAllocate), output(Output), Stamp(0), Hits(0),
+    Misses(0), Writebacks(0) {
+
+  if( (ways == 0) || (lineSize == 0) ){
+    output->fatal(CALL_INFO, -1, "Error: L1 ways and line size must be non-zero\n");
+  }
+  if( (lineSize & (lineSize-1)) != 0 ){
+    output->fatal(CALL_INFO, -1, "Error: L1 line size must be a power of two; lineSize=%u\n",
+                  lineSize);
+  }
+  if( (Size == 0) || ((Size % ((uint64_t)(ways)*lineSize)) != 0) ){
+    output->fatal(CALL_INFO, -1,
+                  "Error: L1 size must be a non-zero multiple of ways*lineSize; size=%" PRIu64 "\n",
+                  Size);
+  }
+
+  numSets = (unsigned)(Size / ((uint64_t)(ways)*lineSize));
+  Tags.resize((size_t)(numSets)*ways, {0, 0, false, false});
+
+  output->verbose(CALL_INFO, 2, 0,
+                  "Initialized L1 cache: %u sets x %u ways x %u bytes\n",
+                  numSets, ways, lineSize);
+}
+
+RevL1Cache::~RevL1Cache(){
+}
+
+unsigned RevL1Cache::AccessLine( uint64_t Line, bool Write ){
+  Stamp++;
+  L1Line *Set = &Tags[(size_t)((Line/lineSize) % numSets) * ways];
+
+  // search the set
+  for( unsigned i=0; i<ways; i++ ){
+    if( Set[i].Valid && (Set[i].Tag == Line) ){
+      Hits++;
+      Set[i].LastUse = Stamp;
+      if( Write && writeBack )
+        Set[i].Dirty = true;
+      return hitLatency;
+    }
+  }
+
+  Misses++;
+
+  // write-through/no-allocate stores go straight to memory
+  if( Write && !writeAllocate )
+    return missLatency;
+
+  // select a victim: the first invalid way, otherwise the LRU way
+  unsigned Victim = 0;
+  for( unsigned i=0; i<ways; i++ ){
+    if( !Set[i].Valid ){
+      Victim = i;
+      break;
+    }
+    if( Set[i].LastUse < Set[Victim].LastUse )
+      Victim = i;
+  }
+
+  unsigned Latency = missLatency;
+  if( Set[Victim].Valid && Set[Victim].Dirty ){
+    // the dirty victim must be written back before the fill
+    Writebacks++;
+    Latency += missLatency;
+  }
+
+  Set[Victim].Tag = Line;
+  Set[Victim].LastUse = Stamp;
+  Set[Victim].Valid = true;
+  Set[Victim].Dirty = (Write && writeBack);
+
+  return Latency;
+}
+
+unsigned RevL1Cache::Access( uint64_t Addr, size_t Len, bool Write ){
+  if( Len == 0 )
+    return 0;
+
+  // an access spanning several lines completes with its slowest line
+  uint64_t Line = Addr & ~((uint64_t)(lineSize)-1);
+  uint64_t Last = (Addr + Len - 1) & ~((uint64_t)(lineSize)-1);
+  unsigned Latency = 0;
+  for( ; Line <= Last; Line += lineSize ){
+    unsigned L = AccessLine(Line, Write);
+    if( L > Latency )
+      Latency = L;
+  }
+
+  return Latency;
+}
+
+// EOF
@@ -19,6 +19,33 @@ RevLoader::RevLoader( std::string Exe, std::string Args,
     output->fatal(CALL_INFO, -1, "Error: failed to load executable into memory\n");
 }
 
+RevLoader::RevLoader( std::string Exe, std::string Args,
+                      RevMem *Mem, SST::Output *Output,
+                      std::string Snapshot )
+  : exe(Exe), args(Args), mem(Mem), output(Output),
+    RV32Entry(0x00l), RV64Entry(0x00ull) {
+  if( Snapshot.empty() ){
+    if( !LoadElf() )
+      output->fatal(CALL_INFO, -1, "Error: failed to load executable into memory\n");
+    return ;
+  }
+
+  uint64_t Key = SnapshotKey();
+  if( LoadSnapshot(Snapshot, Key) ){
+    output->verbose(CALL_INFO, 1, 0, "Restored post-load image from snapshot %s\n",
+                    Snapshot.c_str());
+    return ;
+  }
+
+  // missing or stale snapshot; load the binary and replace it
+  if( !LoadElf() )
+    output->fatal(CALL_INFO, -1, "Error: failed to load executable into memory\n");
+  if( !DumpSnapshot(Snapshot, Key) ){
+    output->verbose(CALL_INFO, 1, 0, "Warning: failed to write snapshot %s\n",
+                    Snapshot.c_str());
+  }
+}
+
 RevLoader::~RevLoader(){
 }
 
@@ -63,6 +90,12 @@ bool RevLoader::WriteCacheLine(uint64_t Addr, size_t Len, void *Data){
     return true;
   }
 
+  // untimed loads are copied straight into the backing store or staged
+  // for the memory backend; only timed loads are split into cache lines
+  if( !mem->TimedLoads() ){
+    return mem->LoadMem(Addr,Len,Data);
+  }
+
   // calculate the cache line size
   unsigned lineSize = mem->getLineSize();
   if( lineSize == 0 ){
@@ -80,15 +113,7 @@ bool RevLoader::WriteCacheLine(uint64_t Addr, size_t Len, void *Data){
 
   // calculate the base address of the first cache line
   size_t Total = 0;
-  bool done = false;
-  uint64_t BaseCacheAddr = Addr;
-  while( !done ){
-    if( (BaseCacheAddr%(uint64_t)(lineSize)) == 0 ){
-      done = true;
-    }else{
-      BaseCacheAddr-=1;
-    }
-  }
+  uint64_t BaseCacheAddr = Addr - (Addr%(uint64_t)(lineSize));
 
   // write the first cache line
   size_t TmpSize = (size_t)((BaseCacheAddr+lineSize)-Addr);
@@ -209,10 +234,17 @@ bool RevLoader::LoadElf32(char *membuf, size_t sz){
                       ph[i].p_filesz,
                       (uint8_t*)(membuf+ph[i].p_offset));
       }
-      std::vector<uint8_t> zeros(ph[i].p_memsz - ph[i].p_filesz);
-      WriteCacheLine(ph[i].p_paddr + ph[i].p_filesz,
-                     ph[i].p_memsz - ph[i].p_filesz,
-                     &zeros[0]);
+      // bss only needs to be written explicitly for timed loads.  RevMem's
+      // own backing store is an anonymous mapping that reads as zero.  A
+      // preloaded memHierarchy backend must also return zero for memory that
+      // was never written (e.g. backing = "mmap"); otherwise set
+      // enable_preload=0 so that bss is written through the timed path
+      if( mem->TimedLoads() && (ph[i].p_memsz > ph[i].p_filesz) ){
+        std::vector<uint8_t> zeros(ph[i].p_memsz - ph[i].p_filesz);
+        WriteCacheLine(ph[i].p_paddr + ph[i].p_filesz,
+                       ph[i].p_memsz - ph[i].p_filesz,
+                       &zeros[0]);
+      }
     }
   }
 
@@ -354,10 +386,17 @@ bool RevLoader::LoadElf64(char *membuf, size_t sz){
                       ph[i].p_filesz,
                       (uint8_t*)(membuf+ph[i].p_offset));
       }
-      std::vector<uint8_t> zeros(ph[i].p_memsz - ph[i].p_filesz);
-      WriteCacheLine(ph[i].p_paddr + ph[i].p_filesz,
-                     ph[i].p_memsz - ph[i].p_filesz,
-                     &zeros[0]);
+      // bss only needs to be written explicitly for timed loads.  RevMem's
+      // own backing store is an anonymous mapping that reads as zero.  A
+      // preloaded memHierarchy backend must also return zero for memory that
+      // was never written (e.g. backing = "mmap"); otherwise set
+      // enable_preload=0 so that bss is written through the timed path
+      if( mem->TimedLoads() && (ph[i].p_memsz > ph[i].p_filesz) ){
+        std::vector<uint8_t> zeros(ph[i].p_memsz - ph[i].p_filesz);
+        WriteCacheLine(ph[i].p_paddr + ph[i].p_filesz,
+                       ph[i].p_memsz - ph[i].p_filesz,
+                       &zeros[0]);
+      }
     }
   }
 
@@ -599,6 +638,131 @@ bool RevLoader::LoadElf(){
   return true;
 }
 
+uint64_t RevLoader::SnapshotKey(){
+  int fd = open(exe.c_str(), O_RDONLY);
+  struct stat FileStats;
+  if( (fd < 0) || (fstat(fd,&FileStats) < 0) )
+    output->fatal(CALL_INFO, -1, "Error: failed to stat executable file: %s\n", exe.c_str() );
+
+  size_t FileSize = FileStats.st_size;
+  char *membuf = (char *)(mmap(NULL,FileSize, PROT_READ, MAP_PRIVATE, fd, 0));
+  close(fd);
+  if( membuf == MAP_FAILED )
+    output->fatal(CALL_INFO, -1, "Error: failed to map executable file: %s\n", exe.c_str() );
+
+  uint64_t Key = RevSnapshot::Hash(0xcbf29ce484222325ull, membuf, FileSize);
+  // argv[0] is the executable path and is written into the stack image
+  Key = RevSnapshot::Hash(Key, exe.data(), exe.size());
+  Key = RevSnapshot::Hash(Key, args.data(), args.size());
+  munmap( membuf, FileSize );
+
+  return Key;
+}
+
+bool RevLoader::LoadSnapshot(const std::string &File, uint64_t Key){
+  int fd = open(File.c_str(), O_RDONLY);
+  if( fd < 0 )
+    return false;
+  struct stat FileStats;
+  if( (fstat(fd,&FileStats) < 0) || (FileStats.st_size == 0) ){
+    close(fd);
+    return false;
+  }
+
+  size_t Len = FileStats.st_size;
+  char *Buf = (char *)(mmap(NULL, Len, PROT_READ, MAP_PRIVATE, fd, 0));
+  close(fd);
+  if( Buf == MAP_FAILED )
+    return false;
+
+  // reject snapshots of a different binary, argument list or format
+  size_t Off = 0;
+  uint64_t Magic = 0, SKey = 0;
+  uint32_t Version = 0;
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Magic) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, Version) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, SKey) ||
+      (Magic != _REVSNAP_MAGIC_) || (Version != _REVSNAP_VERSION_) ||
+      (SKey != Key) ){
+    output->verbose(CALL_INFO, 1, 0, "Ignoring stale snapshot %s\n", File.c_str());
+    munmap( Buf, Len );
+    return false;
+  }
+
+  // the memory image validates itself before modifying any state
+  if( !mem->RestoreImage(Buf, Len, Off) ){
+    munmap( Buf, Len );
+    return false;
+  }
+
+  // from here on the memory state has been replaced; a truncated
+  // snapshot cannot be recovered from
+  uint64_t NSyms = 0, NArgs = 0;
+  bool Ok = RevSnapshot::Get<uint32_t>(Buf, Len, Off, RV32Entry) &&
+            RevSnapshot::Get<uint64_t>(Buf, Len, Off, RV64Entry) &&
+            RevSnapshot::Get<ElfInfo>(Buf, Len, Off, elfinfo) &&
+            RevSnapshot::Get<uint64_t>(Buf, Len, Off, NSyms);
+  for( uint64_t i=0; Ok && (i<NSyms); i++ ){
+    std::string Sym;
+    uint64_t Val = 0;
+    Ok = RevSnapshot::GetStr(Buf, Len, Off, Sym) &&
+         RevSnapshot::Get<uint64_t>(Buf, Len, Off, Val);
+    symtable[Sym] = Val;
+  }
+  Ok = Ok && RevSnapshot::Get<uint64_t>(Buf, Len, Off, NArgs);
+  for( uint64_t i=0; Ok && (i<NArgs); i++ ){
+    std::string Arg;
+    Ok = RevSnapshot::GetStr(Buf, Len, Off, Arg);
+    argv.push_back(Arg);
+  }
+  munmap( Buf, Len );
+
+  if( !Ok )
+    output->fatal(CALL_INFO, -1, "Error: snapshot %s is truncated\n", File.c_str() );
+
+  return true;
+}
+
+bool RevLoader::DumpSnapshot(const std::string &File, uint64_t Key){
+  // write to a private file and rename it so that concurrent
+  // runs never observe a partial snapshot
+  std::string Tmp = File + "." + std::to_string(getpid());
+  std::ofstream os(Tmp, std::ios::binary | std::ios::trunc);
+  if( !os.is_open() )
+    return false;
+
+  RevSnapshot::Put<uint64_t>(os, _REVSNAP_MAGIC_);
+  RevSnapshot::Put<uint32_t>(os, _REVSNAP_VERSION_);
+  RevSnapshot::Put<uint64_t>(os, Key);
+  if( !mem->DumpImage(os) ){
+    os.close();
+    unlink(Tmp.c_str());
+    return false;
+  }
+
+  RevSnapshot::Put<uint32_t>(os, RV32Entry);
+  RevSnapshot::Put<uint64_t>(os, RV64Entry);
+  RevSnapshot::Put<ElfInfo>(os, elfinfo);
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(symtable.size()));
+  for( auto &S : symtable ){
+    RevSnapshot::PutStr(os, S.first);
+    RevSnapshot::Put<uint64_t>(os, S.second);
+  }
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(argv.size()));
+  for( auto &A : argv ){
+    RevSnapshot::PutStr(os, A);
+  }
+
+  os.close();
+  if( os.fail() || (rename(Tmp.c_str(), File.c_str()) != 0) ){
+    unlink(Tmp.c_str());
+    return false;
+  }
+
+  output->verbose(CALL_INFO, 1, 0, "Wrote post-load image snapshot %s\n", File.c_str());
+  return true;
+}
+
 uint64_t RevLoader::GetSymbolAddr(std::string Symbol){
   uint64_t tmp = 0x00ull;
   if( symtable.find(Symbol) != symtable.end() ){
@@ -11,11 +11,12 @@
 #include "../include/RevMem.h"
 #include <math.h>
 #include <memory>
+#include <sys/mman.h>
 
 RevMem::RevMem( unsigned long MemSize, RevOpts *Opts,
                 RevMemCtrl *Ctrl, SST::Output *Output )
-  : physMem(nullptr), memSize(MemSize), opts(Opts), ctrl(Ctrl), output(Output),
-    stacktop(0x00ull) {
+  : physMem(nullptr), memSize(MemSize), opts(Opts), ctrl(Ctrl), preload(true), l1(nullptr),
+    output(Output), stacktop(0x00ull) {
   // Note: this constructor assumes the use of the memHierarchy backend
   pageSize = 262144; //Page Size (in Bytes)
   addrShift = int(log(pageSize) / log(2.0));
@@ -45,23 +46,21 @@ RevMem::RevMem( unsigned long MemSize, RevOpts *Opts,
 }
 
 RevMem::RevMem( unsigned long MemSize, RevOpts *Opts, SST::Output *Output )
-  : physMem(nullptr), memSize(MemSize), opts(Opts), ctrl(nullptr), output(Output),
-    stacktop(0x00ull) {
-
-  // allocate the backing memory
-  physMem = new char [memSize];
+  : physMem(nullptr), memSize(MemSize), opts(Opts), ctrl(nullptr), preload(false), l1(nullptr),
+    output(Output), stacktop(0x00ull) {
+
+  // allocate the backing memory; anonymous pages read as zero and are
+  // only committed by the host when first written, so untouched regions
+  // (bss, heap, unused stack) cost nothing at startup
+  void *Base = mmap(nullptr, memSize, PROT_READ|PROT_WRITE,
+                    MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+  if( Base == MAP_FAILED )
+    output->fatal(CALL_INFO, -1, "Error: could not allocate backing memory\n");
+  physMem = static_cast<char *>(Base);
   pageSize = 262144; //Page Size (in Bytes)
   addrShift = int(log(pageSize) / log(2.0));
   nextPage = 0;
 
-  if( !physMem )
-    output->fatal(CALL_INFO, -1, "Error: could not allocate backing memory\n");
-
-  // zero the memory
-  for( unsigned long i=0; i<memSize; i++ ){
-    physMem[i] = 0;
-  }
-
   // We initialize StackTop to the size of memory minus 1024 bytes
   // This allocates 1024 bytes for program header information to contain
   // the ARGC and ARGV information
@@ -79,7 +78,8 @@ RevMem::RevMem( unsigned long MemSize, RevOpts *Opts, SST::Output *Output )
 
 RevMem::~RevMem(){
   if( physMem )
-    delete[] physMem;
+    munmap(physMem, memSize);
+  delete l1;
 }
 
 bool RevMem::outstandingRqsts(){
@@ -111,6 +111,7 @@ void RevMem::HandleMemFault(unsigned width){
 }
 
 bool RevMem::SetFuture(uint64_t Addr){
+  MemGuard Lock(this);
   FutureRes.push_back(Addr);
   std::sort( FutureRes.begin(), FutureRes.end() );
   FutureRes.erase( std::unique( FutureRes.begin(), FutureRes.end() ), FutureRes.end() );
@@ -118,6 +119,7 @@ bool RevMem::SetFuture(uint64_t Addr){
 }
 
 bool RevMem::RevokeFuture(uint64_t Addr){
+  MemGuard Lock(this);
   for( unsigned i=0; i<FutureRes.size(); i++ ){
     if( FutureRes[i] == Addr ){
       FutureRes.erase( FutureRes.begin() + i );
@@ -129,6 +131,7 @@ bool RevMem::RevokeFuture(uint64_t Addr){
 }
 
 bool RevMem::StatusFuture(uint64_t Addr){
+  MemGuard Lock(this);
   for( unsigned i=0; i<FutureRes.size(); i++ ){
     if( FutureRes[i] == Addr )
       return true;
@@ -136,29 +139,39 @@ bool RevMem::StatusFuture(uint64_t Addr){
   return false;
 }
 
+void RevMem::ClearReservation(unsigned Hart){
+  MemGuard Lock(this);
+  LRSC.erase(std::remove_if(LRSC.begin(), LRSC.end(),
+                            [Hart](const std::tuple<unsigned,uint64_t,unsigned,uint64_t*>& R){
+                              return std::get<LRSC_HART>(R) == Hart;
+                            }),
+             LRSC.end());
+}
+
+void RevMem::BreakReservations(unsigned Hart, uint64_t Addr, size_t Len){
+  // reservations cover an aligned doubleword; a store by any other
+  // hart that touches it makes that hart's store conditional fail
+  const uint64_t First = Addr & ~7ull;
+  const uint64_t Last  = (Addr + (Len ? Len : 1) - 1) & ~7ull;
+  LRSC.erase(std::remove_if(LRSC.begin(), LRSC.end(),
+                            [=](const std::tuple<unsigned,uint64_t,unsigned,uint64_t*>& R){
+                              const uint64_t G = std::get<LRSC_ADDR>(R) & ~7ull;
+                              return (std::get<LRSC_HART>(R) != Hart) &&
+                                     (G >= First) && (G <= Last);
+                            }),
+             LRSC.end());
+}
+
 bool RevMem::LRBase(unsigned Hart, uint64_t Addr, size_t Len,
                     void *Target, uint8_t aq, uint8_t rl,
                     bool *Hazard,
                     StandardMem::Request::flags_t flags){
-  std::vector<std::tuple<unsigned,uint64_t,unsigned,uint64_t*>>::iterator it;
-
-  for( it = LRSC.begin(); it != LRSC.end(); ++it ){
-    if( (Hart == std::get<LRSC_HART>(*it)) &&
-        (Addr == std::get<LRSC_ADDR>(*it)) ){
-      // existing reservation; return w/ error
-      uint32_t *Tmp = reinterpret_cast<uint32_t *>(Target);
-      Tmp[0] = 0x01ul;
-      return false;
-    }else if( (Hart != std::get<LRSC_HART>(*it)) &&
-              (Addr == std::get<LRSC_ADDR>(*it)) ){
-      // existing reservation; return w/ error
-      uint32_t *Tmp = reinterpret_cast<uint32_t *>(Target);
-      Tmp[0] = 0x01ul;
-      return false;
-    }
-  }
+  MemGuard Lock(this);
 
-  // didn't find a colliding object; add it
+  // a hart holds a single reservation; a new load reserved replaces
+  // it.  other harts may hold reservations on the same address until
+  // one of them stores to it
+  ClearReservation(Hart);
   LRSC.push_back(std::tuple<unsigned,uint64_t,
                  unsigned,uint64_t*>(Hart,Addr,(unsigned)(aq|(rl<<1)),
                                      reinterpret_cast<uint64_t *>(Target)));
@@ -181,6 +194,8 @@ bool RevMem::LRBase(unsigned Hart, uint64_t Addr, size_t Len,
     for( unsigned i=0; i<Len; i++ ){
       DataMem[i] = BaseMem[i];
     }
+    if( l1 )
+      L1Cost[Hart] = l1->Access(physAddr, Len, false);
     // clear the hazard
     *Hazard = false;
   }
@@ -191,65 +206,35 @@ bool RevMem::LRBase(unsigned Hart, uint64_t Addr, size_t Len,
 bool RevMem::SCBase(unsigned Hart, uint64_t Addr, size_t Len,
                     void *Data, void *Target, uint8_t aq, uint8_t rl,
                     StandardMem::Request::flags_t flags){
+  MemGuard Lock(this);
   std::vector<std::tuple<unsigned,uint64_t,unsigned,uint64_t*>>::iterator it;
 
+  // rd is written at the width of the access: 0 on success, 1 on failure
+  char *Result = (char *)(Target);
+  for( unsigned i=0; i<Len; i++ ){
+    Result[i] = 0;
+  }
+
   for( it = LRSC.begin(); it != LRSC.end(); ++it ){
     if( (Hart == std::get<LRSC_HART>(*it)) &&
         (Addr == std::get<LRSC_ADDR>(*it)) ){
-      // existing reservation; test to see if the value matches
-      uint64_t *TmpTarget = std::get<LRSC_VAL>(*it);
-      uint64_t *TmpData = reinterpret_cast<uint64_t *>(Data);
-
-      if( Len == 32 ){
-        uint32_t A = 0;
-        uint32_t B = 0;
-        for( unsigned i=0; i<Len; i++ ){
-          A |= ((uint32_t)(TmpTarget[i]) << i);
-          B |= ((uint32_t)(TmpData[i]) << i);
-        }
-        if( (A & B) == 0 ){
-          uint32_t *Tmp = (uint32_t *)(Target);
-          Tmp[0] = 0x1;
-          return false;
-        }
-      }else{
-        uint64_t A = 0;
-        uint64_t B = 0;
-        for( unsigned i=0; i<Len; i++ ){
-          A |= ((uint64_t)(TmpTarget[i]) << i);
-          B |= ((uint64_t)(TmpData[i]) << i);
-        }
-        if( (A & B) == 0 ){
-          uint64_t *Tmp = reinterpret_cast<uint64_t *>(Target);
-          Tmp[0] = 0x1;
-          return false;
-        }
-      }
-
-      // everything has passed so far,
-      // write the value back to memory
-      WriteMem(Hart, Addr,Len,Data,flags);
-
-      // write zeros to target
-      for( unsigned i=0; i<Len; i++ ){
-        uint64_t *Tmp = reinterpret_cast<uint64_t *>(Target);
-        Tmp[i] = 0x0;
-      }
-
-      // erase the entry
+      // the reservation is still intact; consume it and store, which
+      // breaks every other hart's reservation on the address
       LRSC.erase(it);
+      WriteMem(Hart,Addr,Len,Data,flags);
       return true;
     }
   }
 
-  // failed, write a nonzero value to target
-  uint32_t *Tmp = reinterpret_cast<uint32_t *>(Target);
-  Tmp[0] = 0x1;
+  // failed; any reservation this hart held on another address is lost
+  ClearReservation(Hart);
+  Result[0] = 0x1;
 
   return false;
 }
 
 unsigned RevMem::RandCost( unsigned Min, unsigned Max ){
+  MemGuard Lock(this);
   unsigned R = 0;
 
   srand(time(NULL));
@@ -259,6 +244,29 @@ unsigned RevMem::RandCost( unsigned Min, unsigned Max ){
   return R;
 }
 
+void RevMem::SetL1Cache( RevL1Cache *L1 ){
+  if( ctrl ){
+    output->fatal(CALL_INFO, -1, "Error: the internal L1 cache model cannot be used with memHierarchy\n");
+  }
+  delete l1;
+  l1 = L1;
+  L1Cost.clear();
+}
+
+unsigned RevMem::MemCost( unsigned Hart, unsigned Min, unsigned Max ){
+  MemGuard Lock(this);
+  if( !l1 )
+    return RandCost(Min,Max);
+
+  // consume the latency recorded by the hart's last data read
+  auto it = L1Cost.find(Hart);
+  if( it == L1Cost.end() )
+    return 0;
+  unsigned C = it->second;
+  it->second = 0;
+  return C;
+}
+
 void RevMem::FlushTLB(){
   TLB.clear();
   LRUQueue.clear();
@@ -373,11 +381,22 @@ bool RevMem::isValidVirtAddr(const uint64_t vAddr){
   if( vAddr >= heapstart && vAddr <= heapend ){
     return true;
   }
+
+  // heap slices of the other components sharing the backend
+  if( (vAddr >= sharedHeapBase) && (vAddr < sharedHeapTop) ){
+    return true;
+  }
+
+  // stacks of the other components sharing the backend
+  if( sharedStackBottom && (vAddr >= sharedStackBottom) && (vAddr < memSize) ){
+    return true;
+  }
   return false;
 }
 
 
 uint64_t RevMem::AddMemSegAt(const uint64_t& BaseAddr, const uint64_t& SegSize){
+  MemGuard Lock(this);
   // TODO: Check to make sure there's no overlap
   MemSegs.emplace_back(std::make_shared<MemSegment>(BaseAddr, SegSize));
   return BaseAddr;
@@ -389,6 +408,7 @@ uint64_t RevMem::AddMemSegAt(const uint64_t& BaseAddr, const uint64_t& SegSize){
 // 
 // AllocMem is the only way that a user can allocate & deallocate memory 
 uint64_t RevMem::AddRoundedMemSeg(uint64_t BaseAddr, const uint64_t& SegSize, size_t RoundUpSize){
+  MemGuard Lock(this);
   size_t RoundedSegSize = 0;
 
   // Make sure we're not dividing by zero
@@ -449,6 +469,7 @@ uint64_t RevMem::AddRoundedMemSeg(uint64_t BaseAddr, const uint64_t& SegSize, si
 // vector to see if there is a free segment that will fit the new data
 // If there is not a free segment, it will allocate a new segment at the end of the heap
 uint64_t RevMem::AllocMem(const uint64_t& SegSize){
+  MemGuard Lock(this);
   output->verbose(CALL_INFO, 10, 99, "Attempting to allocating %lul bytes on the heap\n", SegSize);
 
   uint64_t NewSegBaseAddr = 0;
@@ -496,6 +517,7 @@ uint64_t RevMem::AllocMem(const uint64_t& SegSize){
 // vector to see if there is a free segment that will fit the new data
 // If its unable to allocate at the location requested it will error. This may change in the future.
 uint64_t RevMem::AllocMemAt(const uint64_t& BaseAddr, const uint64_t& SegSize){
+  MemGuard Lock(this);
   int ret = 0;
   output->verbose(CALL_INFO, 10, 99, "Attempting to allocating %lul bytes on the heap", SegSize);
 
@@ -569,8 +591,14 @@ uint64_t RevMem::AllocMemAt(const uint64_t& BaseAddr, const uint64_t& SegSize){
 
 
 bool RevMem::FenceMem(unsigned Hart){
+  return FenceMem(Hart,
+                  (uint8_t)(RevCPU::RevFence::F_FENCE_IORW),
+                  (uint8_t)(RevCPU::RevFence::F_FENCE_IORW));
+}
+
+bool RevMem::FenceMem(unsigned Hart, uint8_t Pred, uint8_t Succ){
   if( ctrl ){
-    return ctrl->sendFENCE(Hart);
+    return ctrl->sendFENCE(Hart,Pred,Succ);
   }
   return true;  // base RevMem support does nothing here
 }
@@ -579,6 +607,7 @@ bool RevMem::AMOMem(unsigned Hart, uint64_t Addr, size_t Len,
                     void *Data, void *Target,
                     bool *Hazard,
                     StandardMem::Request::flags_t flags){
+  MemGuard Lock(this);
 #ifdef _REV_DEBUG_
   std::cout << "AMO of " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -701,6 +730,7 @@ bool RevMem::AMOMem(unsigned Hart, uint64_t Addr, size_t Len,
 
 bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data,
                        StandardMem::Request::flags_t flags){
+  MemGuard Lock(this);
 #ifdef _REV_DEBUG_
   std::cout << "Writing " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -709,6 +739,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data,
     std::cout << "Found special write. Val = " << std::hex << *(int*)(Data) << std::dec << std::endl;
   }
   RevokeFuture(Addr); // revoke the future if it is present; ignore the return
+  BreakReservations(Hart, Addr, Len);
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
 
@@ -735,6 +766,11 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data,
       for( unsigned i=0; i< (Len-span); i++ ){
         BaseMem[i] = DataMem[i];
       }
+      if( l1 ){
+        // stores are posted; only update the cache state
+        l1->Access(physAddr, Len-span, true);
+        l1->Access(adjPhysAddr, span, true);
+      }
     }
     BaseMem = &physMem[adjPhysAddr];
     if( ctrl ){
@@ -766,6 +802,9 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data,
       for( unsigned i=0; i<Len; i++ ){
         BaseMem[i] = DataMem[i];
       }
+      // stores are posted; only update the cache state
+      if( l1 )
+        l1->Access(physAddr, Len, true);
     }
   }
   memStats.bytesWritten += Len;
@@ -774,6 +813,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data,
 
 
 bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data ){
+  MemGuard Lock(this);
 #ifdef _REV_DEBUG_
   std::cout << "Writing " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -782,6 +822,7 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data ){
     std::cout << "Found special write. Val = " << std::hex << *(int*)(Data) << std::dec << std::endl;
   }
   RevokeFuture(Addr); // revoke the future if it is present; ignore the return
+  BreakReservations(Hart, Addr, Len);
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
 
@@ -822,6 +863,11 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data ){
       for( unsigned i=0; i< (Len-span); i++ ){
         BaseMem[i] = DataMem[i];
       }
+      if( l1 ){
+        // stores are posted; only update the cache state
+        l1->Access(physAddr, Len-span, true);
+        l1->Access(adjPhysAddr, span, true);
+      }
     }
     BaseMem = &physMem[adjPhysAddr];
     if( ctrl ){
@@ -859,13 +905,93 @@ bool RevMem::WriteMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data ){
       for( unsigned i=0; i<Len; i++ ){
         BaseMem[i] = DataMem[i];
       }
+      // stores are posted; only update the cache state
+      if( l1 )
+        l1->Access(physAddr, Len, true);
+    }
+  }
+  memStats.bytesWritten += Len;
+  return true;
+}
+
+bool RevMem::LoadMem( uint64_t Addr, size_t Len, const void *Data ){
+  if( ctrl && !preload )
+    return false;
+
+  // another component sharing the backend delivers the image
+  if( ctrl && !imageOwner )
+    return true;
+
+  // pages are allocated on first touch and are not physically contiguous,
+  // so copy one page-sized chunk at a time
+  const char *DataMem = (const char *)(Data);
+  size_t Cur = 0;
+  while( Cur < Len ){
+    uint64_t VAddr = Addr + Cur;
+    uint64_t physAddr = CalcPhysAddr(VAddr >> addrShift, VAddr);
+    size_t Chunk = (size_t)(pageSize - (VAddr & (pageSize-1)));
+    if( Chunk > (Len-Cur) )
+      Chunk = Len-Cur;
+    if( ctrl ){
+      // the memory backend owns the data; stage it for delivery during init
+      if( !ctrl->sendUntimedWRITERequest(VAddr, (uint32_t)(Chunk), &DataMem[Cur]) )
+        return false;
+    }else{
+      std::memcpy(&physMem[physAddr], &DataMem[Cur], Chunk);
     }
+    Cur += Chunk;
+  }
+
+  memStats.bytesWritten += Len;
+  return true;
+}
+
+bool RevMem::ReadBulk( uint64_t Addr, size_t Len, void *Data ){
+  // memHierarchy owns the data
+  if( ctrl )
+    return false;
+
+  MemGuard Lock(this);
+  char *DataMem = (char *)(Data);
+  size_t Cur = 0;
+  while( Cur < Len ){
+    uint64_t VAddr = Addr + Cur;
+    uint64_t physAddr = CalcPhysAddr(VAddr >> addrShift, VAddr);
+    size_t Chunk = (size_t)(pageSize - (VAddr & (pageSize-1)));
+    if( Chunk > (Len-Cur) )
+      Chunk = Len-Cur;
+    std::memcpy(&DataMem[Cur], &physMem[physAddr], Chunk);
+    Cur += Chunk;
   }
+
+  memStats.bytesRead += Len;
+  return true;
+}
+
+bool RevMem::WriteBulk( uint64_t Addr, size_t Len, const void *Data ){
+  // memHierarchy owns the data
+  if( ctrl )
+    return false;
+
+  MemGuard Lock(this);
+  const char *DataMem = (const char *)(Data);
+  size_t Cur = 0;
+  while( Cur < Len ){
+    uint64_t VAddr = Addr + Cur;
+    uint64_t physAddr = CalcPhysAddr(VAddr >> addrShift, VAddr);
+    size_t Chunk = (size_t)(pageSize - (VAddr & (pageSize-1)));
+    if( Chunk > (Len-Cur) )
+      Chunk = Len-Cur;
+    std::memcpy(&physMem[physAddr], &DataMem[Cur], Chunk);
+    Cur += Chunk;
+  }
+
   memStats.bytesWritten += Len;
   return true;
 }
 
 bool RevMem::ReadMem( uint64_t Addr, size_t Len, void *Data ){
+  MemGuard Lock(this);
 #ifdef _REV_DEBUG_
   std::cout << "OLD READMEM: Reading " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -905,6 +1031,19 @@ bool RevMem::ReadMem( uint64_t Addr, size_t Len, void *Data ){
 
 bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
                      bool *Hazard, StandardMem::Request::flags_t flags){
+  return ReadMem(Hart, Addr, Len, Target, Hazard, flags, true);
+}
+
+bool RevMem::ReadInst(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
+                      bool *Hazard){
+  // instruction fetches are not part of the data cache traffic
+  return ReadMem(Hart, Addr, Len, Target, Hazard, REVMEM_FLAGS(0x00), false);
+}
+
+bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
+                     bool *Hazard, StandardMem::Request::flags_t flags,
+                     bool DataL1){
+  MemGuard Lock(this);
 #ifdef _REV_DEBUG_
   std::cout << "NEW READMEM: Reading " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -941,6 +1080,9 @@ bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
         DataMem[Cur] = BaseMem[i];
         Cur++;
       }
+      if( l1 && DataL1 )
+        L1Cost[Hart] = std::max(l1->Access(physAddr, Len-span, false),
+                                l1->Access(adjPhysAddr, span, false));
       // clear the hazard
       *Hazard = false;
     }
@@ -954,6 +1096,8 @@ bool RevMem::ReadMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
       for( unsigned i=0; i<Len; i++ ){
         DataMem[i] = BaseMem[i];
       }
+      if( l1 && DataL1 )
+        L1Cost[Hart] = l1->Access(physAddr, Len, false);
       // clear the hazard
       *Hazard = false;
     }
@@ -1061,6 +1205,7 @@ void RevMem::WriteDouble( unsigned Hart, uint64_t Addr, double Value ){
 *   the same RevMem instance
 */
 uint32_t RevMem::GetNewThreadPID(){
+  MemGuard Lock(this);
 
   #ifdef _REV_DEBUG_
   std::cout << "RevMem: New PID being given: " << PIDCount+1 << std::endl; 
@@ -1101,6 +1246,7 @@ uint32_t RevMem::GetNewThreadPID(){
     // 3. Deallocating memory that hasn't been allocated 
     // - |---- FreeSeg ----| ==> SegFault :/ 
 uint64_t RevMem::DeallocMem(uint64_t BaseAddr, uint64_t Size){
+  MemGuard Lock(this);
   output->verbose(CALL_INFO, 10, 99, 
                   "Attempting to deallocate %lul bytes starting at BaseAddr = 0x%lx\n",
                   Size, BaseAddr);
@@ -1202,19 +1348,271 @@ void RevMem::InitHeap(const uint64_t& EndOfStaticData){
 }
 
 uint64_t RevMem::ExpandHeap(uint64_t Size){
+  MemGuard Lock(this);
    // We don't want multiple concurrent processes changing the heapend 
    // at the same time (ie. two ThreadCtx calling brk)
   uint64_t NewHeapEnd = heapend + Size;
   
   // Check if we are out of heap space (ie. heapend >= bottom of stack)
-  if( NewHeapEnd > maxHeapSize ){
+  if( !heapLimit && (NewHeapEnd > maxHeapSize) ){
     output->fatal(CALL_INFO, 7,  "Out Of Memory --- Attempted to expand heap to 0x%lx which goes beyond the maxHeapSize = 0x%x set in the python configuration. If unset, this value will be equal to 1/4 of memSize.",
                   NewHeapEnd, maxHeapSize);
   }
+  if( heapLimit && (NewHeapEnd > heapLimit) ){
+    output->fatal(CALL_INFO, 7, "Out Of Memory --- Attempted to expand heap to 0x%lx which goes beyond the end of this component's heap slice = 0x%lx",
+                  NewHeapEnd, heapLimit);
+  }
   // update the heapend
   heapend = NewHeapEnd;
 
   return heapend;
 }
 
+/// @brief Moves the program break to Addr if it lies beyond the current heap end
+/// @param Addr: requested program break
+/// The compare and the expansion happen under one lock so that harts
+/// clocked on different host threads cannot both grow from the same end
+uint64_t RevMem::Brk(uint64_t Addr){
+  MemGuard Lock(this);
+  if( Addr > heapend )
+    ExpandHeap(Addr - heapend);
+  return heapend;
+}
+
+/// @brief Splits the heap between the components sharing a memory backend
+/// @param Rank: index of this component
+/// @param Ranks: number of components sharing the backend
+void RevMem::PartitionHeap(unsigned Rank, unsigned Ranks){
+  uint64_t Slice = ((uint64_t)(maxHeapSize) / Ranks) & ~((uint64_t)(pageSize)-1);
+  if( Slice == 0 ){
+    output->fatal(CALL_INFO, -1, "Error: maxHeapSize=0x%x is too small to split across %u components\n",
+                  maxHeapSize, Ranks);
+  }
+
+  // the whole window stays addressable so that heap pointers can
+  // be passed between components; we only allocate from our slice
+  sharedHeapBase = heapstart;
+  sharedHeapTop  = heapstart + maxHeapSize;
+  heapstart = sharedHeapBase + ((uint64_t)(Rank) * Slice);
+  heapend   = heapstart;
+  heapLimit = heapstart + Slice;
+
+  FreeMemSegs.clear();
+  FreeMemSegs.emplace_back(std::make_shared<MemSegment>(heapstart, Slice));
+}
+
+/// @brief Gives each component sharing a memory backend its own stack
+/// @param Rank: index of this component
+/// @param Ranks: number of components sharing the backend
+void RevMem::PartitionStack(unsigned Rank, unsigned Ranks){
+  // rank 0 keeps the stack the loader built the program arguments on;
+  // the others stack up below it, clear of each other and of rank 0
+  sharedStackBottom = stacktop - ((uint64_t)(Ranks) * _STACK_SIZE_);
+  stacktop -= (uint64_t)(Rank) * _STACK_SIZE_;
+  if( sharedStackBottom <= sharedHeapTop ){
+    output->fatal(CALL_INFO, -1, "Error: the stacks of %u components collide with the heap\n",
+                  Ranks);
+  }
+}
+
+bool RevMem::DumpImage(std::ostream &os){
+  if( ctrl ){
+    output->verbose(CALL_INFO, 1, 0,
+                    "Warning: memory images cannot be captured from memHierarchy\n");
+    return false;
+  }
+
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(memSize));
+  RevSnapshot::Put<uint32_t>(os, pageSize);
+  RevSnapshot::Put<uint32_t>(os, (uint32_t)(maxHeapSize));
+  RevSnapshot::Put<uint64_t>(os, stacktop);
+  RevSnapshot::Put<uint64_t>(os, heapstart);
+  RevSnapshot::Put<uint64_t>(os, heapend);
+
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(MemSegs.size()));
+  for( auto Seg : MemSegs ){
+    RevSnapshot::Put<uint64_t>(os, Seg->getBaseAddr());
+    RevSnapshot::Put<uint64_t>(os, Seg->getSize());
+  }
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(FreeMemSegs.size()));
+  for( auto Seg : FreeMemSegs ){
+    RevSnapshot::Put<uint64_t>(os, Seg->getBaseAddr());
+    RevSnapshot::Put<uint64_t>(os, Seg->getSize());
+  }
+
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(pageMap.size()));
+  for( auto &P : pageMap ){
+    RevSnapshot::Put<uint64_t>(os, P.first);
+    RevSnapshot::Put<uint32_t>(os, P.second.first);
+  }
+
+  // physical pages are handed out in order, so the touched
+  // image is the contiguous block below nextPage
+  RevSnapshot::Put<uint32_t>(os, nextPage);
+  os.write(physMem, (std::streamsize)((uint64_t)(nextPage) << addrShift));
+
+  return os.good();
+}
+
+bool RevMem::RestoreImage(const char *Buf, size_t Len, size_t &Off){
+  uint64_t MemSize = 0;
+  uint32_t PageSize = 0;
+  uint32_t MaxHeapSize = 0;
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, MemSize) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, PageSize) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, MaxHeapSize) )
+    return false;
+
+  // the layout depends upon the memory configuration; reject it
+  // before any state is modified
+  if( (MemSize != memSize) || (PageSize != pageSize) || (MaxHeapSize != maxHeapSize) ){
+    output->verbose(CALL_INFO, 1, 0,
+                    "Warning: memory image was captured with a different memory configuration\n");
+    return false;
+  }
+  if( ctrl && !preload ){
+    output->verbose(CALL_INFO, 1, 0,
+                    "Warning: memory images can only be restored into memHierarchy with enable_preload\n");
+    return false;
+  }
+
+  uint64_t StackTop, HeapStart, HeapEnd, NSegs;
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, StackTop) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, HeapStart) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, HeapEnd) )
+    return false;
+
+  std::vector<std::shared_ptr<MemSegment>> Segs[2];
+  for( unsigned s=0; s<2; s++ ){
+    if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, NSegs) )
+      return false;
+    for( uint64_t i=0; i<NSegs; i++ ){
+      uint64_t Base, Size;
+      if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Base) ||
+          !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Size) )
+        return false;
+      Segs[s].push_back(std::make_shared<MemSegment>(Base, Size));
+    }
+  }
+
+  uint64_t NPages = 0;
+  std::map<uint64_t, std::pair<uint32_t, bool>> Pages;
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, NPages) )
+    return false;
+  for( uint64_t i=0; i<NPages; i++ ){
+    uint64_t VPage;
+    uint32_t PPage;
+    if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, VPage) ||
+        !RevSnapshot::Get<uint32_t>(Buf, Len, Off, PPage) )
+      return false;
+    Pages[VPage] = std::pair<uint32_t, bool>(PPage, true);
+  }
+
+  uint32_t NextPage = 0;
+  if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, NextPage) )
+    return false;
+  uint64_t ImageSize = (uint64_t)(NextPage) << addrShift;
+  if( (ImageSize > memSize) || (ImageSize > (Len - Off)) )
+    return false;
+
+  // every mapped page must lie within the image
+  for( auto &P : Pages ){
+    if( P.second.first >= NextPage )
+      return false;
+  }
+
+  // commit the image
+  stacktop  = StackTop;
+  heapstart = HeapStart;
+  heapend   = HeapEnd;
+  MemSegs     = Segs[0];
+  FreeMemSegs = Segs[1];
+  pageMap   = Pages;
+  nextPage  = NextPage;
+  FlushTLB();
+
+  if( ctrl ){
+    // hand each touched page to the memory backend during init; as
+    // with LoadMem, only one component sharing the backend delivers it
+    if( imageOwner ){
+      for( auto &P : pageMap ){
+        ctrl->sendUntimedWRITERequest(P.first << addrShift, pageSize,
+                                      &Buf[Off + ((uint64_t)(P.second.first) << addrShift)]);
+      }
+    }
+  }else{
+    std::memcpy(physMem, &Buf[Off], ImageSize);
+  }
+  Off += ImageSize;
+
+  return true;
+}
+
+bool RevMem::DumpReservations(std::ostream &os, ResolveTargetFunc Resolve){
+  RevSnapshot::Put<uint32_t>(os, PIDCount);
+
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(FutureRes.size()));
+  for( auto F : FutureRes ){
+    RevSnapshot::Put<uint64_t>(os, F);
+  }
+
+  // LR/SC targets point into a thread's register file; store them
+  // relative to the owning thread so they survive the restore
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(LRSC.size()));
+  for( auto &R : LRSC ){
+    uint32_t PID = 0;
+    uint64_t Offset = 0;
+    if( !Resolve(std::get<LRSC_VAL>(R), PID, Offset) ){
+      output->verbose(CALL_INFO, 1, 0,
+                      "Warning: failed to resolve the LR/SC reservation target at 0x%" PRIx64 "\n",
+                      std::get<LRSC_ADDR>(R));
+      return false;
+    }
+    RevSnapshot::Put<uint32_t>(os, (uint32_t)(std::get<LRSC_HART>(R)));
+    RevSnapshot::Put<uint64_t>(os, std::get<LRSC_ADDR>(R));
+    RevSnapshot::Put<uint32_t>(os, (uint32_t)(std::get<LRSC_AQRL>(R)));
+    RevSnapshot::Put<uint32_t>(os, PID);
+    RevSnapshot::Put<uint64_t>(os, Offset);
+  }
+
+  return os.good();
+}
+
+bool RevMem::RestoreReservations(const char *Buf, size_t Len, size_t &Off,
+                                 RebuildTargetFunc Rebuild){
+  uint64_t N = 0;
+  if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, PIDCount) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, N) )
+    return false;
+
+  FutureRes.clear();
+  for( uint64_t i=0; i<N; i++ ){
+    uint64_t F = 0;
+    if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, F) )
+      return false;
+    FutureRes.push_back(F);
+  }
+
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, N) )
+    return false;
+  LRSC.clear();
+  for( uint64_t i=0; i<N; i++ ){
+    uint32_t Hart, AQRL, PID;
+    uint64_t Addr, Offset;
+    if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, Hart) ||
+        !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Addr) ||
+        !RevSnapshot::Get<uint32_t>(Buf, Len, Off, AQRL) ||
+        !RevSnapshot::Get<uint32_t>(Buf, Len, Off, PID) ||
+        !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Offset) )
+      return false;
+    uint64_t *Target = Rebuild(PID, Offset);
+    if( !Target )
+      return false;
+    LRSC.push_back(std::tuple<unsigned,uint64_t,
+                   unsigned,uint64_t*>(Hart,Addr,AQRL,Target));
+  }
+
+  return true;
+}
+
 // EOF
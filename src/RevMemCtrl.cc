@@ -20,7 +20,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    RevMemOp::MemOp Op, StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size), Inv(false),
     Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(nullptr), hazard(nullptr){
+    SplitRqst(1), flags(flags), target(nullptr), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
 }
 
 RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr,
@@ -28,7 +29,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr,
                    RevMemOp::MemOp Op, StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size), Inv(false),
     Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(target), hazard(nullptr){
+    SplitRqst(1), flags(flags), target(target), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
 }
 
 RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
@@ -36,7 +38,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size),
     Inv(false), Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(nullptr), hazard(nullptr){
+    SplitRqst(1), flags(flags), target(nullptr), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
   for(unsigned i=0; i<(unsigned)(Size); i++ ){
     membuf.push_back((uint8_t)(buffer[i]));
   }
@@ -47,7 +50,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size),
     Inv(false), Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(target), hazard(nullptr){
+    SplitRqst(1), flags(flags), target(target), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
   for(unsigned i=0; i<(unsigned)(Size); i++ ){
     membuf.push_back((uint8_t)(buffer[i]));
   }
@@ -58,7 +62,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size),
     Inv(false), Op(Op), CustomOpc(0),
-    SplitRqst(1), membuf(buffer), flags(flags), target(nullptr), hazard(nullptr){
+    SplitRqst(1), membuf(buffer), flags(flags), target(nullptr), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
 }
 
 RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
@@ -66,7 +71,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op),
     CustomOpc(CustomOpc), SplitRqst(1), flags(flags),
-    target(target), hazard(nullptr){
+    target(target), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
 }
 
 RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr,
@@ -74,7 +80,8 @@ RevMemOp::RevMemOp(unsigned Hart, uint64_t Addr, uint64_t PAddr,
                    unsigned CustomOpc, RevMemOp::MemOp Op,
                    StandardMem::Request::flags_t flags )
   : Hart(Hart), Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op),
-    CustomOpc(CustomOpc), SplitRqst(1), flags(flags), target(nullptr), hazard(nullptr){
+    CustomOpc(CustomOpc), SplitRqst(1), flags(flags), target(nullptr), hazard(nullptr),
+    FencePred(0), FenceSucc(0), EnqueueTime(0), DispatchTime(0){
   for(unsigned i=0; i<(unsigned)(Size); i++ ){
     membuf.push_back((uint8_t)(buffer[i]));
   }
@@ -103,12 +110,14 @@ RevMemCtrl::~RevMemCtrl(){
 // ---------------------------------------------------------------
 RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
   : RevMemCtrl(id,params), memIface(nullptr), stdMemHandlers(nullptr),
+    timeConverter(nullptr),
     hasCache(false), lineSize(0),
     max_loads(64), max_stores(64), max_flush(64), max_llsc(64),
-    max_readlock(64), max_writeunlock(64), max_custom(64), max_ops(2),
+    max_readlock(64), max_writeunlock(64), max_custom(64), max_amo(64), max_ops(2),
     num_read(0x00ull), num_write(0x00ull), num_flush(0x00ull), num_llsc(0x00ull),
     num_readlock(0x00ull), num_writeunlock(0x00ull), num_custom(0x00ull),
-    num_fence(0x00ull) {
+    prefetcher(nullptr), max_prefetch(16), prefetch_track(64),
+    untimedAvail(true) {
 
   stdMemHandlers = new RevBasicMemCtrl::RevStdMemHandlers(this,output);
 
@@ -121,8 +130,18 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
   max_readlock = params.find<unsigned>("max_readlock", 64);
   max_writeunlock = params.find<unsigned>("max_writeunlock", 64);
   max_custom = params.find<unsigned>("max_custom", 64);
+  max_amo = params.find<unsigned>("max_amo", std::min(64u, max_loads));
+  max_prefetch = params.find<unsigned>("max_prefetch", 16);
+  prefetch_track = params.find<unsigned>("prefetch_track", 64);
   max_ops = params.find<unsigned>("ops_per_cycle", 2);
 
+  // an empty AMO table never admits an AMO and deadlocks the controller;
+  // every AMO also holds a read, so more than max_loads can never be in flight
+  if( (max_amo == 0) || (max_amo > max_loads) ){
+    output->fatal(CALL_INFO, -1, "Error : max_amo=%u must be between 1 and max_loads=%u\n",
+                  max_amo, max_loads);
+  }
+
   rqstQ.reserve(max_ops);
 
   memIface = loadUserSubComponent<Interfaces::StandardMem>(
@@ -134,9 +153,15 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
     output->fatal(CALL_INFO, -1, "Error : memory interface is null\n");
   }
 
+  // the data prefetcher is optional
+  prefetcher = loadUserSubComponent<RevMemPrefetcher>("prefetcher");
+  if( prefetcher ){
+    output->verbose(CALL_INFO, 5, 0, "Data prefetcher enabled\n");
+  }
+
   registerStats();
 
-  registerClock( ClockFreq,
+  timeConverter = registerClock( ClockFreq,
               new Clock::Handler<RevBasicMemCtrl>(this,&RevBasicMemCtrl::clockTick));
 }
 
@@ -189,17 +214,74 @@ void RevBasicMemCtrl::registerStats(){
   stats.push_back(registerStatistic<uint64_t>("AMOMaxuPending"));
   stats.push_back(registerStatistic<uint64_t>("AMOSwapBytes"));
   stats.push_back(registerStatistic<uint64_t>("AMOSwapPending"));
+  stats.push_back(registerStatistic<uint64_t>("PrefetchIssued"));
+  stats.push_back(registerStatistic<uint64_t>("PrefetchUseful"));
+  stats.push_back(registerStatistic<uint64_t>("PrefetchLate"));
+  stats.push_back(registerStatistic<uint64_t>("PrefetchUseless"));
+  stats.push_back(registerStatistic<uint64_t>("ReadQueueDelay"));
+  stats.push_back(registerStatistic<uint64_t>("ReadMemLatency"));
+  stats.push_back(registerStatistic<uint64_t>("ReadTotalLatency"));
+  stats.push_back(registerStatistic<uint64_t>("WriteQueueDelay"));
+  stats.push_back(registerStatistic<uint64_t>("WriteMemLatency"));
+  stats.push_back(registerStatistic<uint64_t>("WriteTotalLatency"));
+  stats.push_back(registerStatistic<uint64_t>("AMOQueueDelay"));
+  stats.push_back(registerStatistic<uint64_t>("AMOMemLatency"));
+  stats.push_back(registerStatistic<uint64_t>("AMOTotalLatency"));
+  stats.push_back(registerStatistic<uint64_t>("OtherQueueDelay"));
+  stats.push_back(registerStatistic<uint64_t>("OtherMemLatency"));
+  stats.push_back(registerStatistic<uint64_t>("OtherTotalLatency"));
+  stats.push_back(registerStatistic<uint64_t>("RqstQDepth"));
 }
 
 void RevBasicMemCtrl::recordStat(RevBasicMemCtrl::MemCtrlStats Stat,
                                  uint64_t Data){
-  if( Stat > RevBasicMemCtrl::MemCtrlStats::AMOSwapPending){
+  if( Stat > RevBasicMemCtrl::MemCtrlStats::RqstQDepth){
     // do nothing
     return ;
   }
   stats[Stat]->addData(Data);
 }
 
+uint64_t RevBasicMemCtrl::getCurrentCycle(){
+  return getCurrentSimTime(timeConverter);
+}
+
+void RevBasicMemCtrl::recordLatency(RevMemOp *op){
+  uint64_t Now = getCurrentCycle();
+  uint64_t QueueDelay = op->getDispatchTime() - op->getEnqueueTime();
+  uint64_t MemLatency = Now - op->getDispatchTime();
+  uint64_t Total = Now - op->getEnqueueTime();
+
+  if( isAMOOp(op) ){
+    if( op->getOp() == RevMemOp::MemOp::MemOpREAD ){
+      // the READ half of an AMO is accounted for when its WRITE completes
+      return ;
+    }
+    recordStat(RevBasicMemCtrl::MemCtrlStats::AMOQueueDelay,QueueDelay);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::AMOMemLatency,MemLatency);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::AMOTotalLatency,Total);
+    return ;
+  }
+
+  switch( op->getOp() ){
+  case RevMemOp::MemOp::MemOpREAD:
+    recordStat(RevBasicMemCtrl::MemCtrlStats::ReadQueueDelay,QueueDelay);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::ReadMemLatency,MemLatency);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::ReadTotalLatency,Total);
+    break;
+  case RevMemOp::MemOp::MemOpWRITE:
+    recordStat(RevBasicMemCtrl::MemCtrlStats::WriteQueueDelay,QueueDelay);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::WriteMemLatency,MemLatency);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::WriteTotalLatency,Total);
+    break;
+  default:
+    recordStat(RevBasicMemCtrl::MemCtrlStats::OtherQueueDelay,QueueDelay);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::OtherMemLatency,MemLatency);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::OtherTotalLatency,Total);
+    break;
+  }
+}
+
 bool RevBasicMemCtrl::sendFLUSHRequest(unsigned Hart,
                                        uint64_t Addr,
                                        uint64_t PAddr,
@@ -211,6 +293,7 @@ bool RevBasicMemCtrl::sendFLUSHRequest(unsigned Hart,
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size,
                               RevMemOp::MemOp::MemOpFLUSH, flags);
   Op->setInv(Inv);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::FlushPending,1);
   return true;
@@ -229,6 +312,7 @@ bool RevBasicMemCtrl::sendREADRequest(unsigned Hart,
                               RevMemOp::MemOp::MemOpREAD, flags);
   Op->setHazard(Hazard);
   *Hazard = true;
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::ReadPending,1);
   return true;
@@ -244,11 +328,33 @@ bool RevBasicMemCtrl::sendWRITERequest(unsigned Hart,
     return true;
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer,
                               RevMemOp::MemOp::MemOpWRITE, flags);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::WritePending,1);
   return true;
 }
 
+bool RevBasicMemCtrl::sendUntimedWRITERequest(uint64_t Addr,
+                                              uint32_t Size,
+                                              const char *buffer){
+  if( !untimedAvail )
+    return false;
+  if( Size == 0 )
+    return true;
+
+  // coalesce with the previous write when the data is contiguous so that
+  // whole segments are delivered as single init events
+  if( !UntimedQ.empty() &&
+      ((UntimedQ.back().first + UntimedQ.back().second.size()) == Addr) ){
+    UntimedQ.back().second.insert(UntimedQ.back().second.end(),
+                                  buffer, buffer+Size);
+  }else{
+    UntimedQ.push_back(std::make_pair(Addr,
+                                      std::vector<uint8_t>(buffer, buffer+Size)));
+  }
+  return true;
+}
+
 bool RevBasicMemCtrl::sendAMORequest(unsigned Hart,
                                      uint64_t Addr,
                                      uint64_t PAddr,
@@ -286,6 +392,7 @@ bool RevBasicMemCtrl::sendAMORequest(unsigned Hart,
 
   // We have the request created and recorded in the AMOTable
   // Push it onto the request queue
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
 
   // now we record the stat for the particular AMO
@@ -325,6 +432,7 @@ bool RevBasicMemCtrl::sendREADLOCKRequest(unsigned Hart,
                               RevMemOp::MemOp::MemOpREADLOCK, flags);
   Op->setHazard(Hazard);
   *Hazard = true;
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::ReadLockPending,1);
   return true;
@@ -340,6 +448,7 @@ bool RevBasicMemCtrl::sendWRITELOCKRequest(unsigned Hart,
     return true;
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer,
                               RevMemOp::MemOp::MemOpWRITEUNLOCK, flags);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::WriteUnlockPending,1);
   return true;
@@ -354,6 +463,7 @@ bool RevBasicMemCtrl::sendLOADLINKRequest(unsigned Hart,
     return true;
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size,
                               RevMemOp::MemOp::MemOpLOADLINK, flags);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::LoadLinkPending,1);
   return true;
@@ -369,6 +479,7 @@ bool RevBasicMemCtrl::sendSTORECONDRequest(unsigned Hart,
     return true;
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer,
                               RevMemOp::MemOp::MemOpSTORECOND, flags);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::StoreCondPending,1);
   return true;
@@ -385,6 +496,7 @@ bool RevBasicMemCtrl::sendCUSTOMREADRequest(unsigned Hart,
     return true;
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, target, Opc,
                               RevMemOp::MemOp::MemOpCUSTOM, flags);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::CustomPending,1);
   return true;
@@ -401,14 +513,21 @@ bool RevBasicMemCtrl::sendCUSTOMWRITERequest(unsigned Hart,
     return true;
   RevMemOp *Op = new RevMemOp(Hart, Addr, PAddr, Size, buffer, Opc,
                               RevMemOp::MemOp::MemOpCUSTOM, flags);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::CustomPending,1);
   return true;
 }
 
-bool RevBasicMemCtrl::sendFENCE(unsigned Hart){
+bool RevBasicMemCtrl::sendFENCE(unsigned Hart, uint8_t Pred, uint8_t Succ){
+  if( (Pred == 0) || (Succ == 0) ){
+    // an empty predecessor or successor set orders nothing
+    return true;
+  }
   RevMemOp *Op = new RevMemOp(Hart,0x00ull, 0x00ull, 0x00,
                               RevMemOp::MemOp::MemOpFENCE, 0x00);
+  Op->setFenceSets(Pred,Succ);
+  Op->setEnqueueTime(getCurrentCycle());
   rqstQ.push_back(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::FencePending,1);
   return true;
@@ -419,12 +538,41 @@ void RevBasicMemCtrl::processMemEvent(StandardMem::Request* ev){
   if( ev == nullptr ){
     output->fatal(CALL_INFO, -1, "Error : Received null memory event\n");
   }
+
+  // retire the request from its hart's in-flight counts before
+  // the handler deletes the associated RevMemOp
+  auto it = outstanding.find(ev->getID());
+  if( (it != outstanding.end()) && (it->second != nullptr) ){
+    RevMemOp *op = it->second;
+    if( !(isAMOOp(op) && (op->getOp() == RevMemOp::MemOp::MemOpREAD)) ){
+      // the READ half of an AMO remains in flight until its WRITE completes
+      updateHartInFlight(op,-1);
+    }
+  }
+
   ev->handle(stdMemHandlers);
+
+  // let a suspended parent component know the response has landed
+  if( notify )
+    notify();
 }
 
 void RevBasicMemCtrl::init(unsigned int phase){
   memIface->init(phase);
 
+  // deliver any staged writes (program image, arguments and stack)
+  // directly to the memory backend without timing
+  for( auto &W : UntimedQ ){
+    memIface->sendUntimedData(new Interfaces::StandardMem::Write(W.first,
+                                                                 W.second.size(),
+                                                                 W.second));
+  }
+  if( !UntimedQ.empty() ){
+    output->verbose(CALL_INFO, 5, 0, "Preloaded %zu untimed write regions\n",
+                    UntimedQ.size());
+    UntimedQ.clear();
+  }
+
   // query the caching infrastructure
   if( phase == 1 ){
     lineSize = memIface->getLineSize();
@@ -440,6 +588,7 @@ void RevBasicMemCtrl::init(unsigned int phase){
 
 void RevBasicMemCtrl::setup(){
   memIface->setup();
+  untimedAvail = false;
 }
 
 void RevBasicMemCtrl::finish(){
@@ -1123,9 +1272,155 @@ bool RevBasicMemCtrl::isRL(unsigned Slot, unsigned Hart){
   return false;
 }
 
+uint8_t RevBasicMemCtrl::getFenceClass(RevMemOp *op){
+  uint8_t R = (uint8_t)(RevCPU::RevFence::F_FENCE_R) |
+              (uint8_t)(RevCPU::RevFence::F_FENCE_I);
+  uint8_t W = (uint8_t)(RevCPU::RevFence::F_FENCE_W) |
+              (uint8_t)(RevCPU::RevFence::F_FENCE_O);
+
+  if( isAMOOp(op) ){
+    // AMOs both read and write memory
+    return (R | W);
+  }
+
+  switch( op->getOp() ){
+  case RevMemOp::MemOp::MemOpREAD:
+  case RevMemOp::MemOp::MemOpREADLOCK:
+  case RevMemOp::MemOp::MemOpLOADLINK:
+    return R;
+  case RevMemOp::MemOp::MemOpWRITE:
+  case RevMemOp::MemOp::MemOpWRITEUNLOCK:
+  case RevMemOp::MemOp::MemOpSTORECOND:
+    return W;
+  case RevMemOp::MemOp::MemOpFENCE:
+    return 0;
+  default:
+    // flush and custom requests are conservatively ordered as both
+    return (R | W);
+  }
+}
+
+void RevBasicMemCtrl::updateHartInFlight(RevMemOp *op, int64_t Count){
+  uint8_t Class = getFenceClass(op);
+  unsigned Hart = op->getHart();
+  if( Class & ((uint8_t)(RevCPU::RevFence::F_FENCE_R) |
+               (uint8_t)(RevCPU::RevFence::F_FENCE_I)) ){
+    HartReads[Hart] += Count;
+  }
+  if( Class & ((uint8_t)(RevCPU::RevFence::F_FENCE_W) |
+               (uint8_t)(RevCPU::RevFence::F_FENCE_O)) ){
+    HartWrites[Hart] += Count;
+  }
+}
+
+bool RevBasicMemCtrl::isFenceClear(unsigned Slot){
+  RevMemOp *Fence = rqstQ[Slot];
+  unsigned Hart = Fence->getHart();
+  uint8_t Pred = Fence->getFencePred();
+
+  // all in-flight predecessor accesses from this hart must drain
+  if( (Pred & ((uint8_t)(RevCPU::RevFence::F_FENCE_R) |
+               (uint8_t)(RevCPU::RevFence::F_FENCE_I))) &&
+      (HartReads[Hart] > 0) ){
+    return false;
+  }
+  if( (Pred & ((uint8_t)(RevCPU::RevFence::F_FENCE_W) |
+               (uint8_t)(RevCPU::RevFence::F_FENCE_O))) &&
+      (HartWrites[Hart] > 0) ){
+    return false;
+  }
+
+  // as must any older predecessor accesses that are still queued
+  for( unsigned i=0; i<Slot; i++ ){
+    if( (rqstQ[i]->getHart() == Hart) &&
+        ((getFenceClass(rqstQ[i]) & Pred) > 0) ){
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RevBasicMemCtrl::isPendingFence(unsigned Slot){
+  RevMemOp *op = rqstQ[Slot];
+  if( isAMOOp(op) && (op->getOp() == RevMemOp::MemOp::MemOpWRITE) ){
+    // the WRITE half of an AMO belongs to an access that was
+    // already ordered when its READ dispatched
+    return false;
+  }
+
+  uint8_t Class = getFenceClass(op);
+  for( unsigned i=0; i<Slot; i++ ){
+    if( (rqstQ[i]->getOp() == RevMemOp::MemOp::MemOpFENCE) &&
+        (rqstQ[i]->getHart() == op->getHart()) &&
+        ((rqstQ[i]->getFenceSucc() & Class) > 0) ){
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RevBasicMemCtrl::isAMOOp(RevMemOp *op){
+  return (((uint32_t)(op->getFlags()) & (uint32_t)(0x3FE00000)) > 0);
+}
+
+uint64_t RevBasicMemCtrl::getAMOLine(uint64_t Addr){
+  // without cache layers we still order AMOs at a nominal
+  // 64 byte granularity
+  uint64_t Line = (lineSize > 0) ? (uint64_t)(lineSize) : 64;
+  return Addr - (Addr % Line);
+}
+
+bool RevBasicMemCtrl::isOnAMOLine(RevMemOp *op, uint64_t Line){
+  if( op->getOp() == RevMemOp::MemOp::MemOpFENCE ){
+    return false;
+  }
+  uint64_t End = op->getAddr() + (op->getSize() > 0 ? op->getSize()-1 : 0);
+  return ( (getAMOLine(op->getAddr()) <= Line) &&
+           (getAMOLine(End) >= Line) );
+}
+
+bool RevBasicMemCtrl::isAMOLineBusy(unsigned Slot){
+  RevMemOp *op = rqstQ[Slot];
+  uint64_t Line = getAMOLine(op->getAddr());
+  bool AMORead = isAMOOp(op);
+
+  // requests that touch a line with an AMO in flight must wait
+  // for the AMO to complete its READ+MODIFY+WRITE sequence
+  for( auto L : AMOLines ){
+    if( isOnAMOLine(op,L) ){
+      return true;
+    }
+  }
+
+  // new AMOs are throttled by the number of AMOs in flight
+  if( AMORead && (AMOLines.size() >= max_amo) ){
+    return true;
+  }
+
+  // preserve ordering against preceding requests on the same line:
+  // nothing may pass a queued AMO and an AMO may not pass a queued request
+  for( unsigned i=0; i<Slot; i++ ){
+    if( AMORead && isOnAMOLine(rqstQ[i],Line) ){
+      return true;
+    }else if( isAMOOp(rqstQ[i]) &&
+              isOnAMOLine(op,getAMOLine(rqstQ[i]->getAddr())) ){
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool RevBasicMemCtrl::isPendingAMO(unsigned Slot){
+  if( isAMOOp(rqstQ[Slot]) &&
+      (rqstQ[Slot]->getOp() == RevMemOp::MemOp::MemOpWRITE) ){
+    // this is the WRITE half of an AMO that already owns its line
+    // and was ordered when its READ was dispatched
+    return false;
+  }
   return (isAQ(Slot,rqstQ[Slot]->getHart()) ||
-          isRL(Slot,rqstQ[Slot]->getHart()));
+          isRL(Slot,rqstQ[Slot]->getHart()) ||
+          isAMOLineBusy(Slot));
 }
 
 bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
@@ -1147,6 +1442,35 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
   // retrieve the next candidate memory operation
   for( unsigned i=0; i<rqstQ.size(); i++ ){
     RevMemOp *op = rqstQ[i];
+
+    if( op->getOp() == RevMemOp::MemOp::MemOpFENCE ){
+      // time to fence!
+      // the fence retires once all of its hart's older predecessor
+      // accesses have completed.  it only holds back younger requests
+      // from the same hart, so other harts continue to dispatch
+      if( isFenceClear(i) ){
+        t_max_ops++;
+        rqstQ.erase(rqstQ.begin()+i);
+        delete op;
+        return true;
+      }
+      continue;
+    }
+
+    // younger requests covered by a fence's successor set must wait
+    if( isPendingFence(i) ){
+      continue;
+    }
+
+    // determine if we have any AMOs that would prevent us
+    // from dispatching this request.  if this returns 'true'
+    // then we skip this request and consider the next one;
+    // AMO ordering is tracked per cache line, so requests to
+    // unrelated lines are free to proceed
+    if( isPendingAMO(i) ){
+      continue;
+    }
+
     if( isMemOpAvail(op,
                      t_max_loads,
                      t_max_stores,
@@ -1159,27 +1483,8 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
       // op is good to execute, build a StandardMem packet
       t_max_ops++;
 
-      if( op->getOp() == RevMemOp::MemOp::MemOpFENCE ){
-        // time to fence!
-        // saturate and exit this cycle
-        // no need to build a StandardMem request
-        t_max_ops = max_ops;
-        rqstQ.erase(rqstQ.begin()+i);
-        num_fence+=1;
-        delete op;
-        return true;
-      }
-
-      // determine if we have any AMOs that would prevent us
-      // from dispatching this request.  if this returns 'true'
-      // then we can't dispatch the request.  note that
-      // we do this after processing FENCE requests
-      if( isPendingAMO(i) ){
-        t_max_ops = max_ops;
-        return true;
-      }
-
       // build a StandardMem request
+      size_t NumOutstanding = outstanding.size();
       if( !buildStandardMemRqst(op, success) ){
         output->fatal(CALL_INFO, -1, "Error : failed to build memory request");
         return false;
@@ -1187,6 +1492,19 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
 
       // sent the request, remove it
       if( success ){
+        if( isAMOOp(op) && (op->getOp() == RevMemOp::MemOp::MemOpREAD) ){
+          // the line now belongs to this AMO until its WRITE completes
+          AMOLines.insert(getAMOLine(op->getAddr()));
+        }
+        if( !(isAMOOp(op) && (op->getOp() == RevMemOp::MemOp::MemOpWRITE)) ){
+          // the WRITE half of an AMO was accounted for with its READ
+          updateHartInFlight(op,(int64_t)(outstanding.size()-NumOutstanding));
+          op->setDispatchTime(getCurrentCycle());
+        }
+        if( prefetcher && hasCache && op->isCacheable() && !isAMOOp(op) &&
+            (op->getOp() == RevMemOp::MemOp::MemOpREAD) ){
+          trainPrefetcher(op);
+        }
         rqstQ.erase(rqstQ.begin()+i);
       }else{
         // go ahead and max out our current request window
@@ -1244,7 +1562,88 @@ unsigned RevBasicMemCtrl::getNumSplitRqsts(RevMemOp *op){
   return count;
 }
 
+void RevBasicMemCtrl::trackPrefetch(uint64_t Line){
+  PrefetchLines[Line] = false;
+  PrefetchOrder.push_back(Line);
+  if( PrefetchOrder.size() > prefetch_track ){
+    // retire the oldest tracked line; it was never hit by a demand read
+    uint64_t Old = PrefetchOrder.front();
+    PrefetchOrder.pop_front();
+    PrefetchLines.erase(Old);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::PrefetchUseless,1);
+  }
+}
+
+void RevBasicMemCtrl::trainPrefetcher(RevMemOp *op){
+  // classify the demand read against the tracked prefetch lines
+  uint64_t Line = op->getAddr() - (op->getAddr() % lineSize);
+  uint64_t End = op->getAddr() + (op->getSize() > 0 ? op->getSize()-1 : 0);
+  for( ; Line <= End; Line += lineSize ){
+    auto it = PrefetchLines.find(Line);
+    if( it != PrefetchLines.end() ){
+      if( it->second ){
+        recordStat(RevBasicMemCtrl::MemCtrlStats::PrefetchUseful,1);
+      }else{
+        recordStat(RevBasicMemCtrl::MemCtrlStats::PrefetchLate,1);
+      }
+      PrefetchLines.erase(it);
+      PrefetchOrder.remove(Line);
+    }
+    // the demand read already covers this line
+    PrefetchQ.remove(Line);
+  }
+
+  // train the prefetcher and queue any new candidate lines
+  std::vector<uint64_t> Lines;
+  prefetcher->Observe(op->getHart(), op->getAddr(), lineSize, Lines);
+  for( auto L : Lines ){
+    if( (PrefetchLines.find(L) != PrefetchLines.end()) ||
+        (std::find(PrefetchQ.begin(),PrefetchQ.end(),L) != PrefetchQ.end()) ){
+      continue;
+    }
+    PrefetchQ.push_back(L);
+    if( PrefetchQ.size() > max_prefetch ){
+      // drop the stalest candidate
+      PrefetchQ.pop_front();
+    }
+  }
+}
+
+void RevBasicMemCtrl::issuePrefetches(unsigned Slots){
+  // prefetches are low priority: they only use issue slots and
+  // load capacity that demand requests left idle this cycle
+  while( (Slots > 0) && (!PrefetchQ.empty()) &&
+         (PrefetchRqsts.size() < max_prefetch) &&
+         (num_read < max_loads) ){
+    uint64_t Line = PrefetchQ.front();
+    PrefetchQ.pop_front();
+
+    Interfaces::StandardMem::Request *rqst =
+      new Interfaces::StandardMem::Read(Line, (uint64_t)(lineSize), 0);
+    PrefetchRqsts[rqst->getID()] = Line;
+    trackPrefetch(Line);
+    memIface->send(rqst);
+    recordStat(RevBasicMemCtrl::MemCtrlStats::PrefetchIssued,1);
+    Slots--;
+  }
+}
+
+void RevBasicMemCtrl::handlePrefetchResp(StandardMem::ReadResp* ev){
+  auto it = PrefetchRqsts.find(ev->getID());
+  auto Line = PrefetchLines.find(it->second);
+  if( Line != PrefetchLines.end() ){
+    // the line is now resident; later demand hits are useful
+    Line->second = true;
+  }
+  PrefetchRqsts.erase(it);
+  delete ev;
+}
+
 void RevBasicMemCtrl::handleReadResp(StandardMem::ReadResp* ev){
+  if( PrefetchRqsts.find(ev->getID()) != PrefetchRqsts.end() ){
+    handlePrefetchResp(ev);
+    return ;
+  }
   if( std::find(requests.begin(),requests.end(),ev->getID()) != requests.end() ){
     requests.erase(std::find(requests.begin(),requests.end(),ev->getID()));
     RevMemOp *op = outstanding[ev->getID()];
@@ -1293,6 +1692,7 @@ void RevBasicMemCtrl::handleReadResp(StandardMem::ReadResp* ev){
         }
         bool *Hazard = op->getHazard();
         *Hazard = false;
+        recordLatency(op);
         delete op;
       }
       outstanding.erase(ev->getID());
@@ -1316,6 +1716,7 @@ void RevBasicMemCtrl::handleReadResp(StandardMem::ReadResp* ev){
     if( Hazard != nullptr ){
       *Hazard = false;
     }
+    recordLatency(op);
     delete op;
     outstanding.erase(ev->getID());
     delete ev;
@@ -1411,6 +1812,10 @@ void RevBasicMemCtrl::performAMO(std::tuple<unsigned,char *,void *,
                               RevMemOp::MemOp::MemOpWRITE,
                               Tmp->getFlags());
 
+  // the WRITE inherits the timing of the original AMO request
+  Op->setEnqueueTime(Tmp->getEnqueueTime());
+  Op->setDispatchTime(Tmp->getDispatchTime());
+
   bool *Hazard = Tmp->getHazard();
   Op->setHazard(Hazard);
   *Hazard = true;
@@ -1458,6 +1863,7 @@ void RevBasicMemCtrl::handleWriteResp(StandardMem::WriteResp* ev){
       // then delete it
       if( std::get<AMOTABLE_MEMOP>(Entry) == op ){
         AMOTable.erase(i++);
+        AMOLines.erase(getAMOLine(op->getAddr()));
       }else{
         ++i;
       }
@@ -1472,6 +1878,7 @@ void RevBasicMemCtrl::handleWriteResp(StandardMem::WriteResp* ev){
           // this was a write request for an AMO, clear the hazard
           *(op->getHazard()) = false;
         }
+        recordLatency(op);
         delete op;
       }
       outstanding.erase(ev->getID());
@@ -1485,6 +1892,7 @@ void RevBasicMemCtrl::handleWriteResp(StandardMem::WriteResp* ev){
       // this was a write request for an AMO, clear the hazard
       *(op->getHazard()) = false;
     }
+    recordLatency(op);
     delete op;
     outstanding.erase(ev->getID());
     delete ev;
@@ -1506,6 +1914,7 @@ void RevBasicMemCtrl::handleFlushResp(StandardMem::FlushResp* ev){
       // split request exists, determine how to handle it
       if( getNumSplitRqsts(op) == 1 ){
         // this was the last request to service, delete the op
+        recordLatency(op);
         delete op;
       }
       outstanding.erase(ev->getID());
@@ -1515,6 +1924,7 @@ void RevBasicMemCtrl::handleFlushResp(StandardMem::FlushResp* ev){
     }
 
     // no split request exists; handle as normal
+    recordLatency(op);
     delete op;
     outstanding.erase(ev->getID());
     delete ev;
@@ -1536,6 +1946,7 @@ void RevBasicMemCtrl::handleCustomResp(StandardMem::CustomResp* ev){
       // split request exists, determine how to handle it
       if( getNumSplitRqsts(op) == 1 ){
         // this was the last request to service, delete the op
+        recordLatency(op);
         delete op;
       }
       outstanding.erase(ev->getID());
@@ -1545,6 +1956,7 @@ void RevBasicMemCtrl::handleCustomResp(StandardMem::CustomResp* ev){
     }
 
     // no split request exists; handle as normal
+    recordLatency(op);
     delete op;
     outstanding.erase(ev->getID());
     delete ev;
@@ -1566,6 +1978,7 @@ void RevBasicMemCtrl::handleInvResp(StandardMem::InvNotify* ev){
       // split request exists, determine how to handle it
       if( getNumSplitRqsts(op) == 1 ){
         // this was the last request to service, delete the op
+        recordLatency(op);
         delete op;
       }
       outstanding.erase(ev->getID());
@@ -1574,6 +1987,7 @@ void RevBasicMemCtrl::handleInvResp(StandardMem::InvNotify* ev){
     }
 
     // no split request exists; handle as normal
+    recordLatency(op);
     delete op;
     outstanding.erase(ev->getID());
     delete ev;
@@ -1588,27 +2002,20 @@ uint64_t RevBasicMemCtrl::getTotalRqsts(){
 }
 
 bool RevBasicMemCtrl::outstandingRqsts(){
-  return (requests.size() > 0 );
+  // prefetches in flight still land in the cache hierarchy, so
+  // drains and checkpoints must wait for them as well
+  return (requests.size() > 0 ) || (PrefetchRqsts.size() > 0);
 }
 
 bool RevBasicMemCtrl::clockTick(Cycle_t cycle){
 
-  // check to see if the top request is a FENCE
-  if( num_fence > 0 ){
-    if( (num_read + num_write + num_llsc +
-         num_readlock + num_writeunlock +
-         num_custom) != 0 ){
-      // waiting for the outstanding ops to clear
-      recordStat(RevBasicMemCtrl::MemCtrlStats::FencePending,1);
-      return false;
-    }else{
-      // clear the fence and continue processing
-      num_fence--;
-    }
-  }
+  // sample the request queue depth; the accumulated mean
+  // yields the time-averaged occupancy
+  recordStat(RevBasicMemCtrl::MemCtrlStats::RqstQDepth,rqstQ.size());
 
   // process the memory queue
   bool done = false;
+  size_t Depth = rqstQ.size();
   unsigned t_max_ops = 0;
   unsigned t_max_loads = 0;
   unsigned t_max_stores = 0;
@@ -1631,6 +2038,14 @@ bool RevBasicMemCtrl::clockTick(Cycle_t cycle){
     }
   }
 
+  // issue data prefetches with the remaining bandwidth
+  if( prefetcher ){
+    size_t Issued = (Depth > rqstQ.size()) ? (Depth - rqstQ.size()) : 0;
+    if( Issued < max_ops ){
+      issuePrefetches(max_ops - (unsigned)(Issued));
+    }
+  }
+
   return false;
 }
 
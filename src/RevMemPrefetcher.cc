@@ -0,0 +1,133 @@
+//
+// _RevMemPrefetcher_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevMemPrefetcher.h"
+
+using namespace SST;
+using namespace RevCPU;
+
+// ---------------------------------------------------------------
+// RevMemPrefetcher
+// ---------------------------------------------------------------
+RevMemPrefetcher::RevMemPrefetcher(ComponentId_t id, Params& params)
+  : SubComponent(id), output(nullptr) {
+
+  uint32_t verbosity = params.find<uint32_t>("verbose");
+  output = new SST::Output("[RevMemPrefetcher @t]: ", verbosity, 0, SST::Output::STDOUT);
+}
+
+RevMemPrefetcher::~RevMemPrefetcher(){
+  delete output;
+}
+
+// ---------------------------------------------------------------
+// RevNextLinePrefetcher
+// ---------------------------------------------------------------
+RevNextLinePrefetcher::RevNextLinePrefetcher(ComponentId_t id, Params& params)
+  : RevMemPrefetcher(id,params), degree(2), distance(1) {
+  degree = params.find<unsigned>("degree", 2);
+  distance = params.find<unsigned>("distance", 1);
+}
+
+RevNextLinePrefetcher::~RevNextLinePrefetcher(){
+}
+
+void RevNextLinePrefetcher::Observe(unsigned Hart, uint64_t Addr,
+                                    unsigned LineSize,
+                                    std::vector<uint64_t> &Lines){
+  if( LineSize == 0 )
+    return ;
+
+  uint64_t Line = Addr - (Addr % LineSize);
+  for( unsigned i=0; i<degree; i++ ){
+    Lines.push_back(Line + ((uint64_t)(distance+i) * LineSize));
+  }
+}
+
+// ---------------------------------------------------------------
+// RevStridePrefetcher
+// ---------------------------------------------------------------
+RevStridePrefetcher::RevStridePrefetcher(ComponentId_t id, Params& params)
+  : RevMemPrefetcher(id,params), tableSize(16), degree(2), distance(1),
+    regionSize(4096), threshold(2) {
+  tableSize = params.find<unsigned>("table_size", 16);
+  degree = params.find<unsigned>("degree", 2);
+  distance = params.find<unsigned>("distance", 1);
+  regionSize = params.find<uint64_t>("region_size", 4096);
+  threshold = params.find<unsigned>("confidence", 2);
+
+  if( tableSize == 0 ){
+    output->fatal(CALL_INFO, -1, "Error : stride prefetcher table_size must be non-zero\n");
+  }
+  if( regionSize == 0 ){
+    output->fatal(CALL_INFO, -1, "Error : stride prefetcher region_size must be non-zero\n");
+  }
+}
+
+RevStridePrefetcher::~RevStridePrefetcher(){
+}
+
+void RevStridePrefetcher::Observe(unsigned Hart, uint64_t Addr,
+                                  unsigned LineSize,
+                                  std::vector<uint64_t> &Lines){
+  if( LineSize == 0 )
+    return ;
+
+  // entries are indexed by the hart and the region holding the address
+  auto Key = std::make_pair(Hart, Addr/regionSize);
+  auto it = Table.find(Key);
+
+  if( it == Table.end() ){
+    // allocate a new entry, replacing the least recently used
+    if( Table.size() >= tableSize ){
+      Table.erase(LRU.back());
+      LRU.pop_back();
+    }
+    Table[Key] = {Addr, 0, 0};
+    LRU.push_front(Key);
+    return ;
+  }
+
+  // move the entry to the front of the replacement list
+  LRU.remove(Key);
+  LRU.push_front(Key);
+
+  StrideEntry &Entry = it->second;
+  int64_t Stride = (int64_t)(Addr - Entry.LastAddr);
+  if( Stride == 0 ){
+    // repeated access to the same address; nothing to learn
+    return ;
+  }
+
+  if( Stride == Entry.Stride ){
+    Entry.Confidence++;
+  }else{
+    Entry.Stride = Stride;
+    Entry.Confidence = 0;
+  }
+  Entry.LastAddr = Addr;
+
+  if( Entry.Confidence < threshold )
+    return ;
+
+  // prefetch along the confirmed stride, collapsing strides
+  // that fall within the same cache line
+  uint64_t LastLine = Addr - (Addr % LineSize);
+  for( unsigned i=0; i<degree; i++ ){
+    uint64_t Target = Addr + (uint64_t)(Stride * (int64_t)(distance+i));
+    uint64_t Line = Target - (Target % LineSize);
+    if( Line != LastLine ){
+      Lines.push_back(Line);
+      LastLine = Line;
+    }
+  }
+}
+
+// EOF
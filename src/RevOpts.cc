@@ -24,12 +24,14 @@ RevOpts::RevOpts( unsigned NumCores, const int Verbosity )
   // -- table = internal
   // -- memCosts[core] = 0:10
   // -- prefetch depth = 16
+  // -- prefetch streams = 8
   for( unsigned i=0; i<numCores; i++ ){
     startAddr.insert( std::pair<unsigned,uint64_t>(i,(uint64_t)(0x00000000)) );
     machine.insert( std::pair<unsigned,std::string>(i,"G") );
     table.insert( std::pair<unsigned,std::string>(i,"_REV_INTERNAL_") );
     memCosts.push_back(InitialPair);
     prefetchDepth.insert( std::pair<unsigned,unsigned>(i,16) );
+    prefetchStreams.insert( std::pair<unsigned,unsigned>(i,8) );
   }
 }
 
@@ -78,6 +80,27 @@ bool RevOpts::InitPrefetchDepth( std::vector<std::string> Depths ){
   return true;
 }
 
+bool RevOpts::InitPrefetchStreams( std::vector<std::string> Streams ){
+  std::vector<std::string> vstr;
+  for(unsigned i=0; i<Streams.size(); i++ ){
+    std::string s = Streams[i];
+    splitStr(s,':',vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = (unsigned)(std::stoi(vstr[0],nullptr,0));
+    if( Core >= numCores )
+      return false;
+
+    std::string::size_type sz = 0;
+    unsigned Num = (unsigned)(std::stoul(vstr[1],&sz,0));
+
+    prefetchStreams.find(Core)->second = Num;
+    vstr.clear();
+  }
+  return true;
+}
+
 bool RevOpts::InitStartAddrs( std::vector<std::string> StartAddrs ){
   std::vector<std::string> vstr;
 
@@ -224,6 +247,17 @@ bool RevOpts::GetPrefetchDepth( unsigned Core, unsigned &Depth ){
   return true;
 }
 
+bool RevOpts::GetPrefetchStreams( unsigned Core, unsigned &Streams ){
+  if( Core >= numCores )
+    return false;
+
+  if( prefetchStreams.find(Core) == prefetchStreams.end() )
+    return false;
+
+  Streams = prefetchStreams.at(Core);
+  return true;
+}
+
 bool RevOpts::GetStartAddr( unsigned Core, uint64_t &StartAddr ){
   if( Core > numCores )
     return false;
@@ -10,199 +10,340 @@
 
 #include "../include/RevPrefetcher.h"
 
-bool RevPrefetcher::IsAvail(uint64_t Addr){
+RevPrefetcher::RevPrefetcher(RevMem *Mem, RevFeature *Feature,
+                             unsigned Depth, unsigned Streams)
+  : mem(Mem), feature(Feature), depth(Depth), streams(Streams), window(0),
+    hashMask(0), Stamp(0), iStack(nullptr), iHazard(nullptr), lastPC(0),
+    lastSize(0), lastBranch(false){
 
-  // note: this logic now considers compressed instructions
-  uint64_t lastAddr = 0x00ull;
-  for( unsigned i=0; i<baseAddr.size(); i++ ){
-    lastAddr = baseAddr[i] + (depth*4);
-    if( (Addr >= baseAddr[i]) && (Addr < lastAddr) ){
-      // found it, fetch the address
-      // first, calculate the vector offset
-      uint32_t Off = 0;
-      if( Addr == baseAddr[i] ){
-        Off = 0;  // lets avoid division by zero
-      }else{
-        Off = (uint32_t)((Addr-baseAddr[i])/4);
-      }
-      if( Off > (depth-1) ){
-        // some sort of error occurred
-        return false;
-      }
+  // a compressed instruction at the end of a stream needs the
+  // adjacent stream to be resident, so we need at least two slots
+  if( depth == 0 )
+    depth = 1;
+  if( streams < 2 )
+    streams = 2;
+  window = (uint64_t)(depth)*4;
 
-      if( iStack[i][Off] == REVPREF_INIT_ADDR ){
-        // the instruction hasn't been filled yet, stall
-        return false;
-      }
+  // size the hash index to at least twice the number of streams
+  unsigned HashSize = 1;
+  while( HashSize < (streams*2) )
+    HashSize <<= 1;
+  hashMask = HashSize-1;
+  hashIdx.resize(HashSize, -1);
 
-      // we may be short of instruction width in our current stream
-      // determine if an adjacent stream has the payload
-      if( lastAddr-Addr < 4 ){
-
-        uint32_t TmpInst;
-        bool Fetched = false;
-        if( !FetchUpper(Addr+2, Fetched, TmpInst) ){
-          return false;
-        }
-        if( !Fetched ){
-          // initiated a Fill
-          return false;
-        }
-      }
+  // preallocate all the stream storage
+  slots.resize(streams, {0, 0, 0, false});
+  iStack = new uint32_t[(size_t)(streams)*depth];
+  iHazard = new bool[(size_t)(streams)*depth];
+  for( size_t i=0; i<(size_t)(streams)*depth; i++ ){
+    iStack[i] = REVPREF_INIT_ADDR;
+    iHazard[i] = false;
+  }
 
-      // the instruction is available in the stream cache
-      return true;
-    }
+  for( unsigned i=0; i<REVPREF_BTB_ENTRIES; i++ ){
+    btb[i] = {0, 0, false};
+  }
+}
+
+unsigned RevPrefetcher::LineStart(unsigned Slot, unsigned Off){
+  unsigned Line = mem->getLineSize();
+  if( Line < 4 )
+    Line = 64;
+  uint64_t Addr = slots[Slot].Base + ((uint64_t)(Off)*4);
+  Addr -= (Addr % Line);
+  if( Addr < slots[Slot].Base )
+    return 0;
+  return (unsigned)((Addr - slots[Slot].Base)/4);
+}
+
+bool RevPrefetcher::IsBranch(uint32_t Inst){
+  if( (Inst & 0b11) == 0b11 ){
+    // jal or conditional branch
+    return ((Inst & 0x7F) == 0b1101111) || ((Inst & 0x7F) == 0b1100011);
+  }
+  // c.jal (rv32), c.j, c.beqz, c.bnez
+  uint32_t Funct3 = (Inst >> 13) & 0b111;
+  return ((Inst & 0b11) == 0b01) &&
+    ((Funct3 == 0b001 && feature->IsRV32()) ||
+     (Funct3 == 0b101) || (Funct3 == 0b110) || (Funct3 == 0b111));
+}
+
+void RevPrefetcher::Train(uint64_t Addr, uint32_t Inst){
+  // the previous jal/branch was taken; remember its target
+  if( lastBranch && (Addr != lastPC) && (Addr != (lastPC+lastSize)) ){
+    BTBEntry &E = btb[(lastPC >> 1) % REVPREF_BTB_ENTRIES];
+    E.PC = lastPC;
+    E.Target = Addr;
+    E.Valid = true;
   }
 
-  // if we reach this point, then the instruction hasn't even triggered
-  // a stream prefetch.  Lets go ahead and initiate one via a 'Fill' operation
-  Fill(Addr);
+  lastPC = Addr;
+  lastSize = ((Inst & 0b11) == 0b11) ? 4 : 2;
+  lastBranch = IsBranch(Inst);
+
+  // start filling the target of a branch we have seen taken before
+  if( lastBranch ){
+    BTBEntry &E = btb[(Addr >> 1) % REVPREF_BTB_ENTRIES];
+    if( E.Valid && (E.PC == Addr) )
+      Prefetch(E.Target);
+  }
+}
+
+int RevPrefetcher::FindStream(uint64_t Addr, unsigned &Off){
+  uint64_t Base = Addr - (Addr % window);
+  int S = hashIdx[Hash(Base)];
+  if( (S < 0) || !slots[S].Valid || (slots[S].Base != Base) )
+    return -1;
+
+  Off = (unsigned)((Addr-Base)/4);
+  slots[S].LastUse = ++Stamp;
+  return S;
+}
+
+bool RevPrefetcher::IsBusy(unsigned Slot){
+  bool *H = &iHazard[(size_t)(Slot)*depth];
+  for( unsigned y=0; y<depth; y++ ){
+    if( H[y] )
+      return true;
+  }
   return false;
 }
 
-bool RevPrefetcher::FetchUpper(uint64_t Addr, bool &Fetched, uint32_t &UInst){
-  uint64_t lastAddr = 0x00ull;
-  for( unsigned i=0; i<baseAddr.size(); i++ ){
-    lastAddr = baseAddr[i] + (depth*4);
-    if( (Addr >= baseAddr[i]) && (Addr < lastAddr) ){
-      uint32_t Off = 0;
-      if( Addr == baseAddr[i] ){
-        Off = 0;  // lets avoid division by zero
-      }else{
-        Off = (uint32_t)((Addr-baseAddr[i])/4);
-      }
-      if( Off > (depth-1) ){
-        // some sort of error occurred
-        Fetched = false;
-        return false;
-      }
+bool RevPrefetcher::IsAvail(uint64_t Addr){
+  unsigned Off = 0;
+  int S = FindStream(Addr, Off);
 
-      if( iStack[i][Off] == REVPREF_INIT_ADDR ){
-        // the instruction hasn't been filled yet, stall
-        Fetched = false;
-        return true;
-      }
+  if( S < 0 ){
+    // the instruction hasn't even triggered a stream prefetch.
+    // Lets go ahead and initiate one via a 'Fill' operation
+    // along with the next sequential line
+    Fill(Addr);
+    Prefetch((Addr - (Addr % window)) + window);
+    return false;
+  }
 
-      // fetch the instruction
-      if( Addr == (baseAddr[i]+(Off*4)) ){
-        UInst = (iStack[i][Off]<<16);
-        Fetched = true;
-        return true;
-      }
+  if( Off < slots[S].Start ){
+    // we branched backwards into the stream; fill the missing head
+    unsigned First = LineStart(S, Off);
+    FillRange(S, First, slots[S].Start);
+    slots[S].Start = First;
+    return false;
+  }
+
+  if( iStack[(size_t)(S)*depth+Off] == REVPREF_INIT_ADDR ){
+    // the instruction hasn't been filled yet, stall
+    return false;
+  }
+
+  // unaligned (compressed) instructions require the upper half
+  // from the next word, which may live in an adjacent stream
+  if( (Addr%4) != 0 ){
+    uint32_t TmpInst;
+    bool Fetched = false;
+    if( !FetchUpper(Addr+2, Fetched, TmpInst) ){
+      return false;
+    }
+    if( !Fetched ){
+      return false;
     }
   }
 
-  Fill(Addr);
+  // the instruction is available in the stream cache
+  return true;
+}
+
+bool RevPrefetcher::IsWaiting(uint64_t Addr){
+  // compressed instructions may straddle streams; never report them
+  if( (Addr%4) != 0 )
+    return false;
+
+  // look the stream up without touching the LRU state
+  uint64_t Base = Addr - (Addr % window);
+  int S = hashIdx[Hash(Base)];
+  if( (S < 0) || !slots[S].Valid || (slots[S].Base != Base) )
+    return false;
+
+  unsigned Off = (unsigned)((Addr-Base)/4);
+  if( Off < slots[S].Start )
+    return false;
+  return iStack[(size_t)(S)*depth+Off] == REVPREF_INIT_ADDR;
+}
+
+bool RevPrefetcher::FetchUpper(uint64_t Addr, bool &Fetched, uint32_t &UInst){
+  unsigned Off = 0;
+  int S = FindStream(Addr, Off);
+
   Fetched = false;
+  if( S < 0 ){
+    Fill(Addr);
+    return true;
+  }
+
+  if( Off < slots[S].Start ){
+    unsigned First = LineStart(S, Off);
+    FillRange(S, First, slots[S].Start);
+    slots[S].Start = First;
+    return true;
+  }
 
+  uint32_t W = iStack[(size_t)(S)*depth+Off];
+  if( W == REVPREF_INIT_ADDR ){
+    // the instruction hasn't been filled yet, stall
+    return true;
+  }
+
+  UInst = (W<<16);
+  Fetched = true;
   return true;
 }
 
 bool RevPrefetcher::InstFetch(uint64_t Addr, bool &Fetched, uint32_t &Inst){
-  // scan the baseAddr vector to see if the address is cached
-  uint64_t lastAddr = 0x00ull;
-  for( unsigned i=0; i<baseAddr.size(); i++ ){
-    lastAddr = baseAddr[i] + (depth*4);
-    if( (Addr >= baseAddr[i]) && (Addr < lastAddr) ){
-      // found it, fetch the address
-      // first, calculate the vector offset
-      uint32_t Off = 0;
-      if( Addr == baseAddr[i] ){
-        Off = 0;  // lets avoid division by zero
-      }else{
-        Off = (uint32_t)((Addr-baseAddr[i])/4);
-      }
-      if( Off > (depth-1) ){
-        // some sort of error occurred
-        Fetched = false;
-        return false;
-      }
+  unsigned Off = 0;
+  int S = FindStream(Addr, Off);
 
-      if( iStack[i][Off] == REVPREF_INIT_ADDR ){
-        // the instruction hasn't been filled yet, stall
-        Fetched = false;
-        return true;
-      }
+  Fetched = false;
+  if( S < 0 ){
+    // we missed in the stream cache, lets perform a fill
+    // along with the next sequential line
+    Fill(Addr);
+    Prefetch((Addr - (Addr % window)) + window);
+    return true;
+  }
 
-      // fetch the instruction
-      if( Addr == (baseAddr[i]+(Off*4)) ){
-        Inst = iStack[i][Off];
-      }else{
-        // compressed instruction, adjust the offset
-        Inst = (iStack[i][Off] >> 16);
-        uint32_t TmpInst;
-        if( !FetchUpper(Addr+2, Fetched, TmpInst) )
-          return false;
-        if( !Fetched ){
-          // we initiated a fill
-          return true;
-        }
-        Inst |= TmpInst;
-      }
+  if( Off < slots[S].Start ){
+    unsigned First = LineStart(S, Off);
+    FillRange(S, First, slots[S].Start);
+    slots[S].Start = First;
+    return true;
+  }
 
-      Fetched = true;
+  uint32_t W = iStack[(size_t)(S)*depth+Off];
+  if( W == REVPREF_INIT_ADDR ){
+    // the instruction hasn't been filled yet, stall
+    return true;
+  }
 
-      // if this is the last instruction in the stream buffer, we need to deallocate the stream
-      if( Off == (depth-1) ){
-        DeleteStream(i);
-        Fill(Addr+2);   // go ahead and fill the next instruction
-      }
+  uint64_t Next = slots[S].Base + window;
 
+  // fetch the instruction
+  if( (Addr%4) == 0 ){
+    Inst = W;
+  }else{
+    // compressed instruction, adjust the offset
+    Inst = (W >> 16);
+    uint32_t TmpInst;
+    if( !FetchUpper(Addr+2, Fetched, TmpInst) )
+      return false;
+    if( !Fetched ){
+      // we initiated a fill
       return true;
     }
+    Inst |= TmpInst;
   }
 
-  // we missed in the stream cache, lets perform a fill
-  Fill(Addr);
-  Fetched = false;
+  Fetched = true;
+
+  // if this is the last instruction in the stream, go ahead
+  // and start filling the next one
+  if( Off == (depth-1) )
+    Prefetch(Next);
+
+  Train(Addr, Inst);
 
   return true;
 }
 
+void RevPrefetcher::Prefetch(uint64_t Addr){
+  unsigned Off = 0;
+  int S = FindStream(Addr, Off);
+  if( S < 0 ){
+    Fill(Addr);
+  }else if( Off < slots[S].Start ){
+    unsigned First = LineStart(S, Off);
+    FillRange(S, First, slots[S].Start);
+    slots[S].Start = First;
+  }
+}
+
 void RevPrefetcher::Fill(uint64_t Addr){
+  uint64_t Base = Addr - (Addr % window);
 
-  // determine if the address is 32bit aligned
-  if((Addr%4)!=0){
-    // not 32bit aligned, adjust the base address by 2 bytes
-    Fill(Addr&0xFFFFFFFFFFFFFFFC);
-    return;
+  // the index is direct mapped, so a resident stream whose base hashes
+  // to the same entry is the victim; otherwise it would be orphaned
+  // with its buffered instructions.  Without a collision, select the
+  // first empty slot, otherwise the least recently used slot without
+  // outstanding fills
+  int Victim = -1;
+  int Owner = hashIdx[Hash(Base)];
+  if( (Owner >= 0) && slots[Owner].Valid ){
+    if( IsBusy(Owner) ){
+      // the colliding stream is waiting on memory; retry on a later cycle
+      return ;
+    }
+    Victim = Owner;
+  }else{
+    for( unsigned i=0; i<streams; i++ ){
+      if( !slots[i].Valid ){
+        Victim = (int)(i);
+        break;
+      }
+      if( IsBusy(i) )
+        continue;
+      if( (Victim < 0) || (slots[i].LastUse < slots[Victim].LastUse) )
+        Victim = (int)(i);
+    }
   }
 
-  // allocate a new stream buffer
-  baseAddr.push_back(Addr);
-  iStack.push_back( new uint32_t[depth] );
-  iHazard.push_back( new bool[depth] );
-
-  // initialize it
-  unsigned x = baseAddr.size()-1;
-  for( unsigned y = 0; y<depth; y++ ){
-    iStack[x][y] = REVPREF_INIT_ADDR;
-    iHazard[x][y] = true;
+  if( Victim < 0 ){
+    // every stream is waiting on memory; retry on a later cycle
+    return ;
   }
 
-  // now fill it
-  for( unsigned y=0; y<depth; y++ ){
-    mem->ReadVal( feature->GetHart(), Addr+(y*4),
-                  (uint32_t *)(&iStack[x][y]),
-                  &(iHazard[x][y]),
-                  REVMEM_FLAGS(0x00) );
+  StreamSlot &S = slots[Victim];
+  if( S.Valid && (hashIdx[Hash(S.Base)] == Victim) )
+    hashIdx[Hash(S.Base)] = -1;
+
+  S.Base = Base;
+  S.LastUse = ++Stamp;
+  S.Valid = true;
+  S.Start = LineStart(Victim, (unsigned)((Addr-Base)/4));
+  hashIdx[Hash(Base)] = Victim;
 
+  // clear the head of the window, then fill from the target's line onwards
+  for( unsigned y=0; y<S.Start; y++ ){
+    iStack[(size_t)(Victim)*depth+y] = REVPREF_INIT_ADDR;
   }
+  FillRange(Victim, S.Start, depth);
 }
 
-void RevPrefetcher::DeleteStream(unsigned i){
-  // delete the target stream as we no longer need it
-  if( i > (baseAddr.size()-1) ){
-    return ;
+void RevPrefetcher::FillRange(unsigned Slot, unsigned First, unsigned Last){
+  uint32_t *I = &iStack[(size_t)(Slot)*depth];
+  bool *H = &iHazard[(size_t)(Slot)*depth];
+
+  // initialize it
+  for( unsigned y=First; y<Last; y++ ){
+    I[y] = REVPREF_INIT_ADDR;
+    H[y] = false;
   }
 
-  // delete it
-  delete [] iStack[i];
-  delete [] iHazard[i];
-  iStack.erase(iStack.begin() + i);
-  iHazard.erase(iHazard.begin() + i);
-  baseAddr.erase(baseAddr.begin() + i);
+  unsigned Line = mem->getLineSize();
+  if( Line < 4 )
+    Line = 64;
+
+  // now fill it with one read per cache line; the hazard
+  // is tracked on the first instruction slot of each read
+  uint64_t Addr = slots[Slot].Base + ((uint64_t)(First)*4);
+  uint64_t End  = slots[Slot].Base + ((uint64_t)(Last)*4);
+  while( Addr < End ){
+    uint64_t LEnd = (Addr - (Addr % Line)) + Line;
+    if( LEnd > End )
+      LEnd = End;
+    unsigned y = (unsigned)((Addr - slots[Slot].Base)/4);
+    mem->ReadInst( feature->GetHart(), Addr, (size_t)(LEnd-Addr),
+                   (void *)(&I[y]),
+                   &(H[y]) );
+    Addr = LEnd;
+  }
 }
 
 // EOF
@@ -9,7 +9,11 @@
 //
 
 #include "../include/RevProc.h"
+#include <algorithm>
 #include <bitset>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <filesystem>
 #include <sys/xattr.h>
 
@@ -53,7 +57,13 @@ RevProc::RevProc( unsigned Id,
     Depth = 16;
   }
 
-  sfetch = new RevPrefetcher(Mem,feature,Depth);
+  unsigned Streams = 0;
+  Opts->GetPrefetchStreams(Id, Streams);
+  if( Streams == 0 ){
+    Streams = 8;
+  }
+
+  sfetch = new RevPrefetcher(Mem,feature,Depth,Streams);
   if( !sfetch )
     output->fatal(CALL_INFO, -1,
                   "Error: failed to create the RevPrefetcher object for core=%d\n", id);
@@ -74,11 +84,6 @@ RevProc::RevProc( unsigned Id,
     output->fatal(CALL_INFO, -1,
                   "Error: failed to initialize the Ecall Table for core=%d\n", id );
 
-  ECALL_buf = new char[64];
-  ECALL_buf[0] = '\0';
-  ECALL_string = "";
-  ECALL_bytesRead = 0;
-
   // reset the core
   if( !Reset() )
     output->fatal(CALL_INFO, -1,
@@ -95,11 +100,8 @@ RevProc::RevProc( unsigned Id,
 }
 
 RevProc::~RevProc(){
-  for( unsigned i=0; i<Extensions.size(); i++ )
-    delete Extensions[i];
   delete sfetch;
   delete feature;
-  delete[] ECALL_buf;
 }
 
 RevProc::RevProcStats RevProc::GetStats(){
@@ -144,7 +146,7 @@ bool RevProc::SingleStepHart(){
   }
 }
 
-bool RevProc::EnableExt(RevExt *Ext, bool Opt){
+bool RevProc::EnableExt(RevInstTableSet &T, RevExt *Ext, bool Opt){
   if( !Ext )
     output->fatal(CALL_INFO, -1, "Error: failed to initialize RISC-V extensions\n");
 
@@ -152,22 +154,22 @@ bool RevProc::EnableExt(RevExt *Ext, bool Opt){
                   "Core %d ; Enabling extension=%s\n",
                   id, Ext->GetName().c_str());
 
-  // add the extension to our vector of enabled objects
-  Extensions.push_back(Ext);
+  // record the extension; only its tables are retained
+  T.ExtNames.push_back(Ext->GetName());
 
   // retrieve all the target instructions
   std::vector<RevInstEntry> IT = Ext->GetInstTable();
 
   // setup the mapping of InstTable to Ext objects
-  InstTable.reserve(InstTable.size() + IT.size());
+  T.InstTable.reserve(T.InstTable.size() + IT.size());
 
   for( unsigned i=0; i<IT.size(); i++ ){
-    InstTable.push_back(IT[i]);
+    T.InstTable.push_back(IT[i]);
     std::pair<unsigned,unsigned> ExtObj =
-      std::pair<unsigned,unsigned>(Extensions.size()-1,i);
-    EntryToExt.insert(
+      std::pair<unsigned,unsigned>(T.ExtNames.size()-1,i);
+    T.EntryToExt.insert(
       std::pair<unsigned,
-        std::pair<unsigned,unsigned>>(InstTable.size()-1,ExtObj));
+        std::pair<unsigned,unsigned>>(T.InstTable.size()-1,ExtObj));
   }
 
   // load the compressed instructions
@@ -177,15 +179,15 @@ bool RevProc::EnableExt(RevExt *Ext, bool Opt){
                     id, Ext->GetName().c_str());
 
     std::vector<RevInstEntry> CT = Ext->GetCInstTable();
-    InstTable.reserve(InstTable.size() + CT.size());
+    T.InstTable.reserve(T.InstTable.size() + CT.size());
 
     for( unsigned i=0; i<CT.size(); i++ ){
-      InstTable.push_back(CT[i]);
+      T.InstTable.push_back(CT[i]);
       std::pair<unsigned,unsigned> ExtObj =
-        std::pair<unsigned,unsigned>(Extensions.size()-1,i);
-      EntryToExt.insert(
+        std::pair<unsigned,unsigned>(T.ExtNames.size()-1,i);
+      T.EntryToExt.insert(
         std::pair<unsigned,
-          std::pair<unsigned,unsigned>>(InstTable.size()-1,ExtObj));
+          std::pair<unsigned,unsigned>>(T.InstTable.size()-1,ExtObj));
     }
     // load the optional compressed instructions
     if( Opt ){
@@ -194,23 +196,26 @@ bool RevProc::EnableExt(RevExt *Ext, bool Opt){
                       id, Ext->GetName().c_str());
       CT = Ext->GetOInstTable();
 
-      InstTable.reserve(InstTable.size() + CT.size());
+      T.InstTable.reserve(T.InstTable.size() + CT.size());
 
       for( unsigned i=0; i<CT.size(); i++ ){
-        InstTable.push_back(CT[i]);
+        T.InstTable.push_back(CT[i]);
         std::pair<unsigned,unsigned> ExtObj =
-          std::pair<unsigned,unsigned>(Extensions.size()-1,i);
-        EntryToExt.insert(
+          std::pair<unsigned,unsigned>(T.ExtNames.size()-1,i);
+        T.EntryToExt.insert(
           std::pair<unsigned,
-            std::pair<unsigned,unsigned>>(InstTable.size()-1,ExtObj));
+            std::pair<unsigned,unsigned>>(T.InstTable.size()-1,ExtObj));
       }
     }
   }
 
+  // the instruction implementations are reached through the table
+  delete Ext;
+
   return true;
 }
 
-bool RevProc::SeedInstTable(){
+bool RevProc::SeedInstTable(RevInstTableSet &T){
   output->verbose(CALL_INFO, 6, 0,
                     "Core %d ; Seeding instruction table for machine model=%s\n",
                     id, feature->GetMachineModel().c_str());
@@ -220,57 +225,57 @@ bool RevProc::SeedInstTable(){
   if( feature->IsModeEnabled(RV_I) ){
     if( feature->GetXlen() == 64 ){
       // load RV32I & RV64; no optional compressed
-      EnableExt(static_cast<RevExt *>(new RV32I(feature,RegFile,mem,output)),false);
-      EnableExt(static_cast<RevExt *>(new RV64I(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV32I(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV64I(feature,RegFile,mem,output)),false);
     }else{
       // load RV32I w/ optional compressed
-      EnableExt(static_cast<RevExt *>(new RV32I(feature,RegFile,mem,output)),true);
+      EnableExt(T,static_cast<RevExt *>(new RV32I(feature,RegFile,mem,output)),true);
     }
   }
 
   // M-Extension
   if( feature->IsModeEnabled(RV_M) ){
-    EnableExt(static_cast<RevExt *>(new RV32M(feature,RegFile,mem,output)),false);
+    EnableExt(T,static_cast<RevExt *>(new RV32M(feature,RegFile,mem,output)),false);
     if( feature->GetXlen() == 64 ){
-      EnableExt(static_cast<RevExt *>(new RV64M(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV64M(feature,RegFile,mem,output)),false);
     }
   }
 
   // A-Extension
   if( feature->IsModeEnabled(RV_A) ){
-    EnableExt(static_cast<RevExt *>(new RV32A(feature,RegFile,mem,output)),false);
+    EnableExt(T,static_cast<RevExt *>(new RV32A(feature,RegFile,mem,output)),false);
     if( feature->GetXlen() == 64 ){
-      EnableExt(static_cast<RevExt *>(new RV64A(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV64A(feature,RegFile,mem,output)),false);
     }
   }
 
   // F-Extension
   if( feature->IsModeEnabled(RV_F) ){
     if( (!feature->IsModeEnabled(RV_D)) && (feature->GetXlen() == 32) ){
-      EnableExt(static_cast<RevExt *>(new RV32F(feature,RegFile,mem,output)),true);
+      EnableExt(T,static_cast<RevExt *>(new RV32F(feature,RegFile,mem,output)),true);
     }else{
-      EnableExt(static_cast<RevExt *>(new RV32F(feature,RegFile,mem,output)),false);
-      EnableExt(static_cast<RevExt *>(new RV64F(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV32F(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV64F(feature,RegFile,mem,output)),false);
 
     }
 #if 0
     if( feature->GetXlen() == 64 ){
-      EnableExt(static_cast<RevExt *>(new RV64D(feature,RegFile,mem,output)));
+      EnableExt(T,static_cast<RevExt *>(new RV64D(feature,RegFile,mem,output)));
     }
 #endif
   }
 
   // D-Extension
   if( feature->IsModeEnabled(RV_D) ){
-    EnableExt(static_cast<RevExt *>(new RV32D(feature,RegFile,mem,output)),false);
+    EnableExt(T,static_cast<RevExt *>(new RV32D(feature,RegFile,mem,output)),false);
     if( feature->GetXlen() == 64 ){
-      EnableExt(static_cast<RevExt *>(new RV64D(feature,RegFile,mem,output)),false);
+      EnableExt(T,static_cast<RevExt *>(new RV64D(feature,RegFile,mem,output)),false);
     }
   }
 
   // PAN Extension
   if( feature->IsModeEnabled(RV_P) ){
-    EnableExt(static_cast<RevExt *>(new RV64P(feature,RegFile,mem,output)),false);
+    EnableExt(T,static_cast<RevExt *>(new RV64P(feature,RegFile,mem,output)),false);
   }
 
   return true;
@@ -330,46 +335,42 @@ std::string RevProc::ExtractMnemonic(RevInstEntry Entry){
   return vstr[0];
 }
 
-bool RevProc::InitTableMapping(){
+bool RevProc::InitTableMapping(RevInstTableSet &T){
   output->verbose(CALL_INFO, 6, 0,
                     "Core %d ; Initializing table mapping for machine model=%s\n",
                     id, feature->GetMachineModel().c_str());
 
-  for( unsigned i=0; i<InstTable.size(); i++ ){
-    NameToEntry.insert(
-      std::pair<std::string,unsigned>(ExtractMnemonic(InstTable[i]),i) );
-    if( !InstTable[i].compressed ){
+  for( unsigned i=0; i<T.InstTable.size(); i++ ){
+    T.NameToEntry.insert(
+      std::pair<std::string,unsigned>(ExtractMnemonic(T.InstTable[i]),i) );
+    if( !T.InstTable[i].compressed ){
       // map normal instruction
-      EncToEntry.insert(
-        std::pair<uint32_t,unsigned>(CompressEncoding(InstTable[i]),i) );
+      T.EncToEntry.insert(
+        std::pair<uint32_t,unsigned>(CompressEncoding(T.InstTable[i]),i) );
       output->verbose(CALL_INFO, 6, 0,
                       "Core %d ; Table Entry %d = %s\n",
                       id,
-                      CompressEncoding(InstTable[i]),
-                      ExtractMnemonic(InstTable[i]).c_str() );
+                      CompressEncoding(T.InstTable[i]),
+                      ExtractMnemonic(T.InstTable[i]).c_str() );
     }else{
       // map compressed instruction
-      CEncToEntry.insert(
-        std::pair<uint32_t,unsigned>(CompressCEncoding(InstTable[i]),i) );
+      T.CEncToEntry.insert(
+        std::pair<uint32_t,unsigned>(CompressCEncoding(T.InstTable[i]),i) );
       output->verbose(CALL_INFO, 6, 0,
                       "Core %d ; Compressed Table Entry %d = %s\n",
                       id,
-                      CompressCEncoding(InstTable[i]),
-                      ExtractMnemonic(InstTable[i]).c_str() );
+                      CompressCEncoding(T.InstTable[i]),
+                      ExtractMnemonic(T.InstTable[i]).c_str() );
     }
   }
   return true;
 }
 
-bool RevProc::ReadOverrideTables(){
+bool RevProc::ReadOverrideTables(RevInstTableSet &T, const std::string &Table){
   output->verbose(CALL_INFO, 6, 0,
                     "Core %d ; Reading override tables for machine model=%s\n",
                     id, feature->GetMachineModel().c_str());
 
-  std::string Table;
-  if( !opts->GetInstTable(id, Table) )
-    return false;
-
   // if the length of the file name is 0, just return
   if( Table == "_REV_INTERNAL_" )
     return true;
@@ -385,12 +386,12 @@ bool RevProc::ReadOverrideTables(){
   unsigned Entry;
   std::map<std::string,unsigned>::iterator it;
   while( infile >> Inst >> Cost ){
-    it = NameToEntry.find(Inst);
-    if( it == NameToEntry.end() )
+    it = T.NameToEntry.find(Inst);
+    if( it == T.NameToEntry.end() )
       output->fatal(CALL_INFO, -1, "Error: could not find instruction in table for map value=%s\n", Inst.c_str() );
 
     Entry = it->second;
-    InstTable[Entry].cost = (unsigned)(std::stoi(Cost,nullptr,0));
+    T.InstTable[Entry].cost = (unsigned)(std::stoi(Cost,nullptr,0));
   }
 
   // close the file
@@ -400,18 +401,36 @@ bool RevProc::ReadOverrideTables(){
 }
 
 bool RevProc::LoadInstructionTable(){
+  std::string Table;
+  if( !opts->GetInstTable(id, Table) )
+    return false;
+
+  // Stage 0: reuse the tables of any core with the same machine model and cost table
+  ITab = RevInstTableRegistry::Find(feature->GetMachineModel(), Table);
+  if( ITab ){
+    output->verbose(CALL_INFO, 6, 0,
+                    "Core %d ; Sharing instruction table for machine model=%s\n",
+                    id, feature->GetMachineModel().c_str());
+    return true;
+  }
+
+  auto T = std::make_shared<RevInstTableSet>();
+
   // Stage 1: load the instruction table for each enable feature
-  if( !SeedInstTable() )
+  if( !SeedInstTable(*T) )
     return false;
 
   // Stage 2: setup the internal mapping tables for performance
-  if( !InitTableMapping() )
+  if( !InitTableMapping(*T) )
     return false;
 
   // Stage 3: examine the user-defined cost tables to see if we need to override the defaults
-  if( !ReadOverrideTables() )
+  if( !ReadOverrideTables(*T, Table) )
     return false;
 
+  // Stage 4: publish the tables for the remaining cores
+  ITab = RevInstTableRegistry::Insert(feature->GetMachineModel(), Table, T);
+
   return true;
 }
 
@@ -482,9 +501,10 @@ bool RevProc::Reset(){
   }
   HART_CTS.set();
 
-  ECALL_buf[0] = '\0';
-  ECALL_bytesRead = 0;
-  ECALL_string.clear();
+  for( unsigned t=0; t<_REV_HART_COUNT_; t++ ){
+    if( HartCtx[t] )
+      HartCtx[t]->GetSyscallState().Clear();
+  }
 
   return true;
 }
@@ -518,10 +538,10 @@ void RevProc::SetupArgs(){
 }
 
 bool RevProc::IsFloat(unsigned Entry){
-  if( (InstTable[Entry].rdClass == RegFLOAT) ||
-      (InstTable[Entry].rs1Class == RegFLOAT) ||
-      (InstTable[Entry].rs2Class == RegFLOAT) ||
-      (InstTable[Entry].rs3Class == RegFLOAT) ){
+  if( (ITab->InstTable[Entry].rdClass == RegFLOAT) ||
+      (ITab->InstTable[Entry].rs1Class == RegFLOAT) ||
+      (ITab->InstTable[Entry].rs2Class == RegFLOAT) ||
+      (ITab->InstTable[Entry].rs3Class == RegFLOAT) ){
     return true;
   }
   return false;
@@ -531,11 +551,11 @@ RevInst RevProc::DecodeCRInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct4  = InstTable[Entry].funct4;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct4  = ITab->InstTable[Entry].funct4;
 
   // registers
   CompInst.rd      = DECODE_RD(Inst);
@@ -553,11 +573,11 @@ RevInst RevProc::DecodeCIInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   CompInst.rd      = DECODE_RD(Inst);
@@ -646,11 +666,11 @@ RevInst RevProc::DecodeCSSInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   CompInst.rs2     = DECODE_LOWER_CRS2(Inst);
@@ -689,11 +709,11 @@ RevInst RevProc::DecodeCIWInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   CompInst.rd      = ((Inst & 0b11100) >> 2);
@@ -723,11 +743,11 @@ RevInst RevProc::DecodeCLInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   CompInst.rd      = ((Inst & 0b11100) >> 2);
@@ -786,11 +806,11 @@ RevInst RevProc::DecodeCSInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   CompInst.rs2     = ((Inst & 0b011100) >> 2);
@@ -825,12 +845,12 @@ RevInst RevProc::DecodeCAInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct2  = InstTable[Entry].funct2;
-  CompInst.funct6  = InstTable[Entry].funct6;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct2  = ITab->InstTable[Entry].funct2;
+  CompInst.funct6  = ITab->InstTable[Entry].funct6;
 
   // registers
   CompInst.rs2     = ((Inst & 0b11100) >> 2);
@@ -847,11 +867,11 @@ RevInst RevProc::DecodeCBInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   CompInst.rs1     = ((Inst & 0b1110000000) >> 7);
@@ -906,11 +926,11 @@ RevInst RevProc::DecodeCJInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = ITab->InstTable[Entry].opcode;
+  CompInst.funct3  = ITab->InstTable[Entry].funct3;
 
   // registers
   uint16_t offset = ((Inst & 0b1111111111100) >> 2);
@@ -1009,8 +1029,8 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
   Enc |= (uint32_t)(funct6 << 12);
 
   bool isCoProcInst = false;
-  std::map<uint32_t,unsigned>::iterator it = CEncToEntry.find(Enc);
-  if( it == CEncToEntry.end() ){
+  std::map<uint32_t,unsigned>::const_iterator it = ITab->CEncToEntry.find(Enc);
+  if( it == ITab->CEncToEntry.end() ){
       if(coProc){
         isCoProcInst = coProc->IssueInst(feature, RegFile, mem, Inst);
       }
@@ -1020,7 +1040,7 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
         Inst = 0;
         Enc = 0;
         Enc |= caddi_op;
-        it = CEncToEntry.find(Enc);
+        it = ITab->CEncToEntry.find(Enc);
       }else{
         output->fatal(CALL_INFO, -1,
                   "Error: failed to decode instruction at PC=0x%" PRIx64 "; Enc=%d\n opc=%x; funct2=%x, funct3=%x, funct4=%x, funct6=%x\n",
@@ -1030,7 +1050,7 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
   }
 
   unsigned Entry = it->second;
-  if( Entry > (InstTable.size()-1) ){
+  if( Entry > (ITab->InstTable.size()-1) ){
     output->fatal(CALL_INFO, -1,
                   "Error: no entry in table for instruction at PC=0x%" PRIx64 "\
                   Opcode = %x Funct2 = %x Funct3 = %x Funct4 = %x Funct6 = %x Enc = %x \n", \
@@ -1042,7 +1062,7 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
 
   RegFile->trigger = false;
 
-  switch( InstTable[Entry].format ){
+  switch( ITab->InstTable[Entry].format ){
   case RVCTypeCR:
     return DecodeCRInst(TmpInst,Entry);
     break;
@@ -1085,13 +1105,13 @@ RevInst RevProc::DecodeRInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
+  DInst.funct3  = ITab->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
-  DInst.funct7  = InstTable[Entry].funct7;
+  DInst.funct7  = ITab->InstTable[Entry].funct7;
 
   // registers
   DInst.rd      = 0x0;
@@ -1099,18 +1119,18 @@ RevInst RevProc::DecodeRInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
 
   // imm
-  if( (InstTable[Entry].imm == FImm) && (InstTable[Entry].rs2Class == RegUNKNOWN)){
+  if( (ITab->InstTable[Entry].imm == FImm) && (ITab->InstTable[Entry].rs2Class == RegUNKNOWN)){
     DInst.imm  = DECODE_IMM12(Inst) & 0b011111; 
   }else{
     DInst.imm     = 0x0;
@@ -1143,11 +1163,11 @@ RevInst RevProc::DecodeIInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
+  DInst.funct3  = ITab->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1157,10 +1177,10 @@ RevInst RevProc::DecodeIInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
 
@@ -1187,11 +1207,11 @@ RevInst RevProc::DecodeSInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
+  DInst.funct3  = ITab->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1201,10 +1221,10 @@ RevInst RevProc::DecodeSInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
 
@@ -1231,10 +1251,10 @@ RevInst RevProc::DecodeUInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
   DInst.funct3  = 0x0;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
@@ -1245,7 +1265,7 @@ RevInst RevProc::DecodeUInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
 
@@ -1267,11 +1287,11 @@ RevInst RevProc::DecodeBInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
+  DInst.funct3  = ITab->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1281,10 +1301,10 @@ RevInst RevProc::DecodeBInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
 
@@ -1309,11 +1329,11 @@ RevInst RevProc::DecodeJInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
+  DInst.funct3  = ITab->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1323,7 +1343,7 @@ RevInst RevProc::DecodeJInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
 
@@ -1349,13 +1369,13 @@ RevInst RevProc::DecodeR4Inst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = ITab->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = ITab->InstTable[Entry].opcode;
+  DInst.funct3  = ITab->InstTable[Entry].funct3;
   DInst.funct2  = DECODE_FUNCT2(Inst);
-  DInst.funct7  = InstTable[Entry].funct7;
+  DInst.funct7  = ITab->InstTable[Entry].funct7;
 
   // registers
   DInst.rd      = 0x0;
@@ -1363,16 +1383,16 @@ RevInst RevProc::DecodeR4Inst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
-  if( InstTable[Entry].rs3Class != RegUNKNOWN ){
+  if( ITab->InstTable[Entry].rs3Class != RegUNKNOWN ){
     DInst.rs3  = DECODE_RS3(Inst);
   }
 
@@ -1572,9 +1592,9 @@ RevInst RevProc::DecodeInst(){
 
   // Stage 7: Look up the value in the table
   bool isCoProcInst = false;
-  std::map<uint32_t,unsigned>::iterator it;
-  it = EncToEntry.find(Enc);
-   if( it == EncToEntry.end() && ((Funct3 == 7) || (Funct3==1)) && (inst65 == 0b10)){
+  std::map<uint32_t,unsigned>::const_iterator it;
+  it = ITab->EncToEntry.find(Enc);
+   if( it == ITab->EncToEntry.end() && ((Funct3 == 7) || (Funct3==1)) && (inst65 == 0b10)){
     //This is kind of a hack, but we may not have found the instruction becasue
     //  Funct3 is overloaded with rounding mode, so if this is a RV32F or RV64F
     //  set Funct3 to zero and check again
@@ -1583,8 +1603,8 @@ RevInst RevProc::DecodeInst(){
     Enc |= (Funct7<<11);
     Enc |= (Imm12<<18);
     Enc |= (fcvtOp<<30);
-    it = EncToEntry.find(Enc);
-    if( it == EncToEntry.end() ){
+    it = ITab->EncToEntry.find(Enc);
+    if( it == ITab->EncToEntry.end() ){
       if(coProc){
         isCoProcInst = coProc->IssueInst(feature, RegFile, mem, Inst);
       }
@@ -1594,7 +1614,7 @@ RevInst RevProc::DecodeInst(){
         Inst = 0;
         Enc = 0;
         Enc |= addi_op;
-        it = EncToEntry.find(Enc);
+        it = ITab->EncToEntry.find(Enc);
       }else{
         // failed to decode the instruction
         output->fatal(CALL_INFO, -1,
@@ -1603,7 +1623,7 @@ RevInst RevProc::DecodeInst(){
                     Enc );
       }
     }
-  }else if(it == EncToEntry.end()){
+  }else if(it == ITab->EncToEntry.end()){
       if(coProc){
         isCoProcInst = coProc->IssueInst(feature, RegFile, mem, Inst);
       }
@@ -1613,7 +1633,7 @@ RevInst RevProc::DecodeInst(){
         Inst = 0;
         Enc = 0;
         Enc |= addi_op;
-        it = EncToEntry.find(Enc);
+        it = ITab->EncToEntry.find(Enc);
       }else{
         // failed to decode the instruction
         output->fatal(CALL_INFO, -1,
@@ -1625,7 +1645,7 @@ RevInst RevProc::DecodeInst(){
 
   unsigned Entry = it->second;
 
-  if( Entry > (InstTable.size()-1) ){
+  if( Entry > (ITab->InstTable.size()-1) ){
       if(coProc){
         isCoProcInst = coProc->IssueInst(feature, RegFile, mem, Inst);
       }
@@ -1635,7 +1655,7 @@ RevInst RevProc::DecodeInst(){
         Inst = 0;
         Enc = 0;
         Enc |= addi_op;
-        it = EncToEntry.find(Enc);
+        it = ITab->EncToEntry.find(Enc);
         Entry = it->second;
       } else {
         output->fatal(CALL_INFO, -1,
@@ -1652,7 +1672,7 @@ RevInst RevProc::DecodeInst(){
 
 
   // Stage 8: Do a full deocode using the target format
-  switch( InstTable[Entry].format ){
+  switch( ITab->InstTable[Entry].format ){
   case RVTypeR:
     return DecodeRInst(Inst,Entry);
     break;
@@ -1946,6 +1966,12 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
   bool rtn = false;
   Stats.totalCycles++;
 
+  // cores without a scheduled thread wait for one to become runnable
+  if( Sched && !SchedTick(currentCycle) ){
+    Stats.cyclesIdle_Total++;
+    return !Sched->Done();
+  }
+
 #ifdef _REV_DEBUG_
   if((currentCycle % 100000000) == 0){
     std::cout << "Current Cycle: " << currentCycle <<  " PC: "
@@ -1985,7 +2011,7 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     HART_CTS[tID] = (GetRegFile(tID)->cost == 0);
   }
 
-  if( HART_CTS.any() && (!Halted)) {
+  if( HART_CTS.any() && (!Halted) && (!Draining)) {
     // fetch the next instruction
     ResetInst(&Inst);
 
@@ -2041,9 +2067,9 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     if( ExecPC != _PAN_FWARE_JUMP_ ){
 
       // Find the instruction extension
-      std::map<unsigned,std::pair<unsigned,unsigned>>::iterator it;
-      it = EntryToExt.find(RegFile->Entry);
-      if( it == EntryToExt.end() ){
+      std::map<unsigned,std::pair<unsigned,unsigned>>::const_iterator it;
+      it = ITab->EntryToExt.find(RegFile->Entry);
+      if( it == ITab->EntryToExt.end() ){
         // failed to find the extension
         output->fatal(CALL_INFO, -1,
                     "Error: failed to find the instruction extension at PC=%" PRIx64 ".", ExecPC );
@@ -2051,10 +2077,7 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
 
       // found the instruction extension
       std::pair<unsigned,unsigned> EToE = it->second;
-      RevExt *Ext = Extensions[EToE.first];
-
-      // Update RegFile (in case of prior context switch)
-      Ext->SetRegFile(RegFile);
+      const std::string &ExtName = ITab->ExtNames[EToE.first];
 
       // -- BEGIN new pipelining implementation
       if( !PendingCtxSwitch ){
@@ -2063,10 +2086,10 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
         Pipeline.back().second.hazard = LH;
       }
 
-      if( (Ext->GetName() == "RV32F") ||
-          (Ext->GetName() == "RV32D") ||
-          (Ext->GetName() == "RV64F") ||
-          (Ext->GetName() == "RV64D") ){
+      if( (ExtName == "RV32F") ||
+          (ExtName == "RV32D") ||
+          (ExtName == "RV64F") ||
+          (ExtName == "RV64D") ){
         Stats.floatsExec++;
       }
 
@@ -2074,8 +2097,9 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
       DependencySet(HartToExec, &(Pipeline.back().second));
       // -- END new pipelining implementation
 
-      // execute the instruction
-      if( !Ext->Execute(EToE.second, Pipeline.back().second, HartToExec) ){
+      // execute the instruction against this core's state
+      if( !ITab->InstTable[RegFile->Entry].func(feature, RegFile, mem,
+                                                Pipeline.back().second) ){
         output->fatal(CALL_INFO, -1,
                     "Error: failed to execute instruction at PC=%" PRIx64 ".", ExecPC );
       }
@@ -2085,7 +2109,7 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
       if(feature->IsRV32()){
         std::cout << "RDT: Executed PC = " << std::hex << ExecPC
                   << " Inst: " << std::setw(23)
-                  << InstTable[Inst.entry].mnemonic
+                  << ITab->InstTable[Inst.entry].mnemonic
                   << " r" << std::dec << (uint32_t)Inst.rd  << "= "
                   << std::hex << RegFile->RV32[Inst.rd]
                   << " r" << std::dec << (uint32_t)Inst.rs1 << "= "
@@ -2098,7 +2122,7 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
       }else{
         std::cout << "RDT: Executed PC = " << std::hex << ExecPC \
                   << " Inst: " << std::setw(23)
-                  << InstTable[Inst.entry].mnemonic
+                  << ITab->InstTable[Inst.entry].mnemonic
                   << " r" << std::dec << (uint32_t)Inst.rd  << "= "
                   << std::hex << RegFile->RV64[Inst.rd]
                   << " r" << std::dec << (uint32_t)Inst.rs1 << "= "
@@ -2153,16 +2177,15 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
       // inject the ALU fault
       if( ALUFault ){
         // inject ALU fault
-        RevExt *Ext = Extensions[EToE.first];
-        if( (Ext->GetName() == "RV32F") ||
-            (Ext->GetName() == "RV32D") ){
+        if( (ExtName == "RV32F") ||
+            (ExtName == "RV32D") ){
           // write an rv32 float rd
           uint32_t rval = rand() % (2^(fault_width));
           uint32_t tmp = (uint32_t)(RegFile->SPF[Inst.rd]);
           tmp |= rval;
           RegFile->SPF[Inst.rd] = (float)(tmp);
-        }else if( (Ext->GetName() == "RV64F") ||
-                  (Ext->GetName() == "RV64D") ){
+        }else if( (ExtName == "RV64F") ||
+                  (ExtName == "RV64D") ){
           // write an rv64 float rd
           uint64_t rval = rand() % (2^(fault_width));
           uint64_t tmp = (uint64_t)(RegFile->DPF[Inst.rd]);
@@ -2234,7 +2257,10 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
   }
 
   // Check for completion states and new tasks
-  if( (GetPC() == _PAN_FWARE_JUMP_) || (GetPC() == 0x00ull) ){
+  if( Sched && (GetPC() == 0x00ull) ){
+    // the scheduler retires the thread once the core drains
+    rtn = true;
+  }else if( (GetPC() == _PAN_FWARE_JUMP_) || (GetPC() == 0x00ull) ){
     // look for more work on the execution queue
     // if no work is found, don't update the PC
     // just wait and spin
@@ -2331,8 +2357,8 @@ uint32_t RevProc::HartToExecPID(){
 }
 
 std::shared_ptr<RevThreadCtx> RevProc::HartToExecCtx(){
-  if( HartToExec <= ActivePIDs.size() )
-    return ThreadTable.at(ActivePIDs.at(HartToExec));
+  if( HartToExec < _REV_HART_COUNT_ )
+    return HartCtx[HartToExec];
   else{
     return 0;
   }
@@ -2352,10 +2378,8 @@ uint32_t RevProc::HartToDecodePID(){
 
 bool RevProc::UpdateRegFile(){
   uint16_t HartID = GetHartID();
-  auto it = ThreadTable.find(ActivePIDs.at(HartID));
-  if( it != ThreadTable.end() ){
-    std::shared_ptr<RevThreadCtx> Ctx = it->second;
-    RegFile = Ctx->GetRegFile();
+  if( HartRegs[HartID] != nullptr ){
+    RegFile = HartRegs[HartID];
     return true;
   }
   else {
@@ -2367,10 +2391,9 @@ bool RevProc::UpdateRegFile(){
 
 
 RevRegFile* RevProc::GetRegFile(uint16_t HartID){
-  auto it = ThreadTable.find(ActivePIDs.at(HartID));
-  if( it != ThreadTable.end() ){
-    std::shared_ptr<RevThreadCtx> Ctx = it->second;
-    return Ctx->GetRegFile();
+  /* Called several times per cycle; the binding is cached by BindHart */
+  if( (HartID < _REV_HART_COUNT_) && (HartRegs[HartID] != nullptr) ){
+    return HartRegs[HartID];
   }
   else {
     output->fatal(CALL_INFO, -1,
@@ -2378,6 +2401,12 @@ RevRegFile* RevProc::GetRegFile(uint16_t HartID){
   }
   return 0;
 }
+
+void RevProc::BindHart(uint16_t HartID, std::shared_ptr<RevThreadCtx> Ctx){
+  ActivePIDs.at(HartID) = Ctx->GetPID();
+  HartRegs[HartID] = Ctx->GetRegFile();
+  HartCtx[HartID] = std::move(Ctx);
+}
 //
 
 bool RevProc::InitThreadTable(){
@@ -2397,15 +2426,16 @@ bool RevProc::InitThreadTable(){
         FirstActivePID,
         ParentPID);
 
-    /* Set the first RegFile as ActiveRegFile */
-    RegFile = DefaultCtx->GetRegFile();
-
-    /* Add first PID to ActivePIDs */
-    ActivePIDs.emplace_back(FirstActivePID);
-
     /* Add to ThreadTable */
     ThreadTable.emplace(FirstActivePID, DefaultCtx);
+
+    /* Add first PID to ActivePIDs and bind the Ctx to the Hart */
+    ActivePIDs.emplace_back(FirstActivePID);
+    BindHart(HartID, DefaultCtx);
   }
+
+  /* Set the first RegFile as ActiveRegFile */
+  RegFile = HartRegs[0];
   return true;
 }
 
@@ -2433,8 +2463,8 @@ bool RevProc::ChangeActivePID(uint32_t NewPID){
                       ActivePIDs.at(HartToExec));
       ThreadTable.erase(ActivePIDs.at(HartToExec));
     }
-    ActivePIDs.at(HartToExec) = NewPID;
-    ActivePIDs.at(HartToDecode) = NewPID;
+    BindHart(HartToExec, NewCtx);
+    BindHart(HartToDecode, NewCtx);
     UpdateRegFile();
     return true;
   }else{
@@ -2461,8 +2491,8 @@ bool RevProc::ChangeActivePID(uint32_t NewPID){
 bool RevProc::ChangeActivePID(uint32_t PID, uint16_t HartID){
   auto NewActiveCtx = ThreadTable.find(PID);
   if( NewActiveCtx != ThreadTable.end() ){
-    if( ActivePIDs.size() >= HartID ){
-      ActivePIDs.at(HartToExec) = PID;
+    if( HartID < ActivePIDs.size() ){
+      BindHart(HartID, NewActiveCtx->second);
       return true;
     } else {
     /* TODO: Maybe don't output fatal? */
@@ -2479,6 +2509,94 @@ bool RevProc::ChangeActivePID(uint32_t PID, uint16_t HartID){
   }
 }
 
+bool RevProc::DumpState(std::ostream &os){
+  RevSnapshot::Put<uint32_t>(os, id);
+  RevSnapshot::Put<uint16_t>(os, HartToDecode);
+  RevSnapshot::Put<uint16_t>(os, HartToExec);
+  RevSnapshot::Put<uint8_t>(os, (uint8_t)(Halted));
+  RevSnapshot::Put<uint64_t>(os, Retired);
+
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(ActivePIDs.size()));
+  for( auto P : ActivePIDs ){
+    RevSnapshot::Put<uint32_t>(os, P);
+  }
+
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(ThreadTable.size()));
+  for( auto &T : ThreadTable ){
+    if( !T.second->DumpCtx(os) )
+      return false;
+  }
+  return os.good();
+}
+
+bool RevProc::RestoreState(const char *Buf, size_t Len, size_t &Off,
+                           std::set<int> &Reopened){
+  uint32_t Id = 0;
+  uint8_t TmpHalted = 0;
+  uint64_t N = 0;
+  if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, Id) ||
+      !RevSnapshot::Get<uint16_t>(Buf, Len, Off, HartToDecode) ||
+      !RevSnapshot::Get<uint16_t>(Buf, Len, Off, HartToExec) ||
+      !RevSnapshot::Get<uint8_t>(Buf, Len, Off, TmpHalted) ||
+      !RevSnapshot::Get<uint64_t>(Buf, Len, Off, Retired) ||
+      (Id != id) )
+    return false;
+  Halted = (TmpHalted != 0);
+
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, N) || (N != ActivePIDs.size()) )
+    return false;
+  for( uint64_t i=0; i<N; i++ ){
+    if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, ActivePIDs[i]) )
+      return false;
+  }
+
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, N) )
+    return false;
+  ThreadTable.clear();
+  for( uint64_t i=0; i<N; i++ ){
+    std::shared_ptr<RevThreadCtx> Ctx = std::make_shared<RevThreadCtx>(0, 0);
+    if( !Ctx->RestoreCtx(Buf, Len, Off, Reopened) )
+      return false;
+    ThreadTable.emplace(Ctx->GetPID(), Ctx);
+  }
+
+  // the checkpoint is taken with an empty pipeline
+  Pipeline.clear();
+  PendingCtxSwitch = false;
+  SwapToParent = false;
+  NextPID = 0;
+  for( unsigned HartID=0; HartID<ActivePIDs.size(); HartID++ ){
+    auto it = ThreadTable.find(ActivePIDs[HartID]);
+    if( it == ThreadTable.end() )
+      return false;
+    BindHart(HartID, it->second);
+  }
+  RegFile = GetRegFile(HartToDecode);
+  ExecPC = GetPC();
+
+  return true;
+}
+
+bool RevProc::ResolveRegTarget(uint64_t *Target, uint32_t &PID, uint64_t &Offset){
+  for( auto &T : ThreadTable ){
+    char *Base = (char *)(T.second->GetRegFile());
+    char *Ptr  = (char *)(Target);
+    if( (Ptr >= Base) && (Ptr < (Base + sizeof(RevRegFile))) ){
+      PID = T.first;
+      Offset = (uint64_t)(Ptr - Base);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t *RevProc::RebuildRegTarget(uint32_t PID, uint64_t Offset){
+  auto it = ThreadTable.find(PID);
+  if( (it == ThreadTable.end()) || (Offset >= sizeof(RevRegFile)) )
+    return nullptr;
+  return (uint64_t *)((char *)(it->second->GetRegFile()) + Offset);
+}
+
 /* Returns vector of all PIDs in the ThreadTable */
 std::vector<uint32_t> RevProc::GetPIDs(){
   std::vector<uint32_t> PIDs;
@@ -2497,7 +2615,7 @@ std::vector<uint32_t> RevProc::GetPIDs(){
 */
 uint32_t RevProc::CreateChildCtx() {
   /* We get the currently executing PID's context as this is assumed to be the parent */
-  std::shared_ptr<RevThreadCtx> ParentCtx = ThreadTable.at(ActivePIDs.at(HartToExec));
+  std::shared_ptr<RevThreadCtx> ParentCtx = HartCtx[HartToExec];
 
   /* Get new PID from global counter in RevMem */
   uint32_t ChildPID = mem->GetNewThreadPID();
@@ -2544,8 +2662,11 @@ void RevProc::InitEcallTable(){
     {55,  &RevProc::ECALL_fchown},          // Not implemented
     {56,  &RevProc::ECALL_openat},
     {57,  &RevProc::ECALL_close},           // Not implemented
-    {63,  &RevProc::ECALL_read},            // Not implemented
+    {63,  &RevProc::ECALL_read},
     {64,  &RevProc::ECALL_write},
+    {65,  &RevProc::ECALL_readv},
+    {67,  &RevProc::ECALL_pread64},
+    {69,  &RevProc::ECALL_preadv},
     {77,  &RevProc::ECALL_tee},             // Not implemented
     {81,  &RevProc::ECALL_sync},            // Not implemented
     {82,  &RevProc::ECALL_fsync},           // Not implemented
@@ -2553,6 +2674,8 @@ void RevProc::InitEcallTable(){
     {93,  &RevProc::ECALL_exit},
     {94,  &RevProc::ECALL_exit_group},      // Not implemented
     {95,  &RevProc::ECALL_waitid},          // Not implemented
+    {96,  &RevProc::ECALL_set_tid_address},
+    {98,  &RevProc::ECALL_futex},
     {99,  &RevProc::ECALL_set_robust_list}, // Not implemented
     {100, &RevProc::ECALL_get_robust_list}, // Not implementedt
     {101, &RevProc::ECALL_nanosleep},       // Not implemented
@@ -2566,12 +2689,13 @@ void RevProc::InitEcallTable(){
     {178, &RevProc::ECALL_gettid},
     {214, &RevProc::ECALL_brk},             // Not implemented
     {215, &RevProc::ECALL_munmap},
-    {220, &RevProc::ECALL_clone},           // Fork functionality works but not clone3
+    {220, &RevProc::ECALL_clone},
     {222, &RevProc::ECALL_mmap},            //
     {403, &RevProc::ECALL_clock_gettime},   // Not implemented
     {404, &RevProc::ECALL_clock_settime},   // Not implemented
     {408, &RevProc::ECALL_timer_gettime},   // Not implemented
     {409, &RevProc::ECALL_timer_settime},   // Not implemented
+    {435, &RevProc::ECALL_clone3},
     };
 }
 
@@ -2600,169 +2724,248 @@ RevProc::ECALL_status_t RevProc::ECALL_setxattr(RevInst& inst){
 RevProc::ECALL_status_t RevProc::ECALL_brk(RevInst& inst){
   uint64_t Addr = RegFile->RV64[10];
 
-  const uint64_t heapend = mem->GetHeapEnd();
-  if( Addr > 0 && Addr > heapend ){
-    uint64_t Size = Addr - heapend;
-    mem->ExpandHeap(Size);
-  } else {
+  if( Addr == 0 ){
     output->fatal(CALL_INFO, 11,
                   "Out of memory / Unable to expand system break (brk) to Addr = 0x%lx", Addr);
   }
+  // another hart may already have moved the break past Addr
+  RegFile->RV64[10] = mem->Brk(Addr);
+  return RevProc::ECALL_status_t::SUCCESS;
+}
+
+uint32_t RevProc::CloneCtx(uint64_t Flags, uint64_t NewSP, uint64_t ParentTID,
+                           uint64_t TLS, uint64_t ChildTID){
+  /*
+   * All the Ctxs of a RevCPU share one address space, so every clone
+   * behaves as if CLONE_VM, CLONE_FS, CLONE_FILES and CLONE_SIGHAND
+   * were set; the remaining flags only describe how the child is set up.
+   * NOTE: if no flags are set, we get fork() like behavior
+   */
+  uint32_t ChildPID = CreateChildCtx();
+  std::shared_ptr<RevThreadCtx> ChildCtx = ThreadTable.at(ChildPID);
+  RevRegFile *ChildRegFile = ChildCtx->GetRegFile();
+
+  /* pthreads hand the child its own stack; fork children share the parent's */
+  if( NewSP != 0 )
+    ChildRegFile->RV64[2] = NewSP;
+
+  /* Thread pointer */
+  if( Flags & CLONE_SETTLS )
+    ChildRegFile->RV64[4] = TLS;
+
+  /* Store the child's TID (a 32bit pid_t) before either thread runs */
+  uint32_t TID = ChildPID;
+  if( (Flags & CLONE_PARENT_SETTID) && (ParentTID != 0) )
+    mem->WriteMem(HartToExec, ParentTID, sizeof(TID), &TID);
+  if( (Flags & CLONE_CHILD_SETTID) && (ChildTID != 0) )
+    mem->WriteMem(HartToExec, ChildTID, sizeof(TID), &TID);
+
+  /* Zeroed when the child exits; this is how pthread_join finds out */
+  if( Flags & CLONE_CHILD_CLEARTID )
+    ChildCtx->SetClearTID(ChildTID);
+
+  if( Sched ){
+    /* The child runs on whichever core picks it up; the parent keeps going */
+    ThreadTable.erase(ChildPID);
+    Sched->Spawn(id, ChildCtx);
+  }else{
+    /*
+    Alert the Proc there needs to be a Ctx switch
+    Pass the PID that will be switched to once the
+    current pipeline is executed until completion
+    */
+    CtxSwitchAlert(ChildPID);
+  }
+
+  /*
+   * In a traditional fork code this looks like:
+   *
+   *   pid_t pid = fork()
+   *   if pid < 0: // Error
+   *   else if pid = 0: // New Child Process
+   *   else: // Parent Process
+   *
+   * The child's a0 was zeroed by CreateChildCtx; the caller stores
+   * the returned PID in the parent's a0
+   */
+  return ChildPID;
+}
+
+/* ========================================================= */
+/* rev_clone(unsigned long flags, unsigned long newsp,       */
+/*           int *parent_tid, unsigned long tls,             */
+/*           int *child_tid)                                 */
+/* ========================================================= */
+RevProc::ECALL_status_t RevProc::ECALL_clone(RevInst& inst){
+  output->verbose(CALL_INFO, 2, 0, "ECALL: clone called\n");
+  uint64_t Flags     = RegFile->RV64[10];
+  uint64_t NewSP     = RegFile->RV64[11];
+  uint64_t ParentTID = RegFile->RV64[12];
+  uint64_t TLS       = RegFile->RV64[13];
+  uint64_t ChildTID  = RegFile->RV64[14];
+
+  /* Parent's return value is the child's PID */
+  RegFile->RV64[10] = CloneCtx(Flags, NewSP, ParentTID, TLS, ChildTID);
   return RevProc::ECALL_status_t::SUCCESS;
 }
 
 /* ======================================================= */
 /* rev_clone3(struct clone_args*, size_t args_size)        */
 /* ======================================================= */
-RevProc::ECALL_status_t RevProc::ECALL_clone(RevInst& inst){
+RevProc::ECALL_status_t RevProc::ECALL_clone3(RevInst& inst){
   uint64_t CloneArgsAddr = RegFile->RV64[10];
+  uint64_t SizeOfCloneArgs = RegFile->RV64[11];
   RevProc::ECALL_status_t rtval = RevProc::ECALL_status_t::SUCCESS;
-  // size_t SizeOfCloneArgs = RegFile()->RV64[11];
-
- if(0 == ECALL_bytesRead){
-    // First time through the function... 
-    /* Fetch the clone_args */
-    // struct clone_args args;  // So while clone_args is a whole struct, we appear to be only
-                                // using the 1st uint64, so that's all we're going to fetch
-    uint64_t* args = reinterpret_cast<uint64_t*>(ECALL_buf);
-    mem->ReadVal<uint64_t>(HartToExec, CloneArgsAddr, args, inst.hazard, REVMEM_FLAGS(0x00));
-    ECALL_bytesRead = 8;
+  RevSyscallState &S = SyscallState();
+
+  /*
+   * struct clone_args { flags, pidfd, child_tid, parent_tid,
+   *                     exit_signal, stack, stack_size, tls, ... }
+   * We only need the first 8 fields, which fit in the scratch buffer
+   */
+  const size_t ArgsLen = 8*sizeof(uint64_t);
+  if( SizeOfCloneArgs < ArgsLen ){
+    RegFile->RV64[10] = (uint64_t)(-EINVAL);
+    return rtval;
+  }
+
+  if(0 == S.BytesRead){
+    /* First time through the function; fetch the clone_args */
+    mem->ReadMem(HartToExec, CloneArgsAddr, ArgsLen, (void *)(S.Buf),
+                 inst.hazard, REVMEM_FLAGS(0x00));
+    S.BytesRead = ArgsLen;
     rtval = RevProc::ECALL_status_t::CONTINUE;
- }else{
-    /*
-    * Parse clone flags
-    * NOTE: if no flags are set, we get fork() like behavior
-    */
-   uint64_t* args = reinterpret_cast<uint64_t*>(ECALL_buf);
-    for( uint64_t bit=1; bit != 0; bit <<= 1 ){
-      switch (*args & bit) {
-        case CLONE_VM:
-          // std::cout << "CLONE_VM is true" << std::endl;
-          break;
-        case CLONE_FS: /* Set if fs info shared between processes */
-          // std::cout << "CLONE_FS is true" << std::endl;
-          break;
-        case CLONE_FILES: /* Set if open files shared between processes */
-          // std::cout << "CLONE_FILES is true" << std::endl;
-          break;
-        case CLONE_SIGHAND: /* Set if signal handlers shared */
-          // std::cout << "CLONE_SIGHAND is true" << std::endl;
-          break;
-        case CLONE_PIDFD: /* Set if a pidfd should be placed in the parent */
-          // std::cout << "CLONE_PIDFD is true" << std::endl;
-          break;
-        case CLONE_PTRACE: /* Set if tracing continues on the child */
-          // std::cout << "CLONE_PTRACE is true" << std::endl;
-          break;
-        case CLONE_VFORK: /* Set if the parent wants the child to wake it up on mm_release */
-          // std::cout << "CLONE_VFORK is true" << std::endl;
-          break;
-        case CLONE_PARENT: /* Set if we want to have the same parent as the cloner */
-          // std::cout << "CLONE_PARENT is true" << std::endl;
-          break;
-        case CLONE_THREAD: /* Set to add to same thread group */
-          // std::cout << "CLONE_THREAD is true" << std::endl;
-          break;
-        case CLONE_NEWNS: /* Set to create new namespace */
-          // std::cout << "CLONE_NEWNS is true" << std::endl;
-          break;
-        case CLONE_SYSVSEM: /* Set to shared SVID SEM_UNDO semantics */
-          // std::cout << "CLONE_SYSVSEM is true" << std::endl;
-          break;
-        case CLONE_SETTLS: /* Set TLS info */
-          // std::cout << "CLONE_SETTLS is true" << std::endl;
-          break;
-        case CLONE_PARENT_SETTID: /* Store TID in userlevel buffer before MM copy */
-          // std::cout << "CLONE_PARENT_SETTID is true" << std::endl;
-          break;
-        case CLONE_CHILD_CLEARTID: /* Register exit futex and memory location to clear */
-          // std::cout << "CLONE_CHILD_CLEARTID is true" << std::endl;
-          break;
-        case CLONE_DETACHED: /* Create clone detached */
-          // std::cout << "CLONE_DETACHED is true" << std::endl;
-          break;
-        case CLONE_UNTRACED: /* Set if the tracing process can't force CLONE_PTRACE on this clone */
-          // std::cout << "CLONE_UNTRACED is true" << std::endl;
-          break;
-        case CLONE_CHILD_SETTID: /* New cgroup namespace */
-          // std::cout << "CLONE_CHILD_SETTID is true" << std::endl;
-          break;
-        case CLONE_NEWCGROUP: /* New cgroup namespace */
-          // std::cout << "CLONE_NEWCGROUP is true" << std::endl;
-          break;
-        case CLONE_NEWUTS: /* New utsname group */
-          // std::cout << "CLONE_NEWUTS is true" << std::endl;
-          break;
-        case CLONE_NEWIPC: /* New ipcs */
-          // std::cout << "CLONE_NEWIPC is true" << std::endl;
-          break;
-        case CLONE_NEWUSER: /* New user namespace */
-          // std::cout << "CLONE_NEWUSER is true" << std::endl;
-          break;
-        case CLONE_NEWPID: /* New pid namespace */
-          // std::cout << "CLONE_NEWPID is true" << std::endl;
-          break;
-        case CLONE_NEWNET: /* New network namespace */
-          // std::cout << "CLONE_NEWNET is true" << std::endl;
-          break;
-        case CLONE_IO: /* Clone I/O Context */
-          // std::cout << "CLONE_IO is true" << std::endl;
-          break;
-        default:
-          break;
-      } // switch
-    } // for
+  }else{
+    uint64_t Args[8];
+    std::memcpy(Args, S.Buf, ArgsLen);
+
+    /* clone3 passes the lowest address of the stack, clone the top */
+    uint64_t NewSP = (Args[5] != 0) ? (Args[5] + Args[6]) : 0;
+    RegFile->RV64[10] = CloneCtx(Args[0], NewSP, Args[3], Args[7], Args[2]);
 
-    /* Get the parent ctx (Current active, executing PID) */
-    std::shared_ptr<RevThreadCtx> ParentCtx = ThreadTable.at(ActivePIDs.at(HartToExec));
+    /*clean up ecall state*/
+    S.BytesRead = 0;
+    S.Buf[0] = '\0';
+  }
+  return rtval;
+}
 
-    /* Create the child ctx */
-    uint32_t ChildPID = CreateChildCtx();
-    std::shared_ptr<RevThreadCtx> ChildCtx = ThreadTable.at(ChildPID);
+/* ================================== */
+/* rev_set_tid_address(int *tidptr)   */
+/* ================================== */
+RevProc::ECALL_status_t RevProc::ECALL_set_tid_address(RevInst& inst){
+  output->verbose(CALL_INFO, 2, 0, "ECALL: set_tid_address called\n");
+  std::shared_ptr<RevThreadCtx> CurrCtx = HartToExecCtx();
+  CurrCtx->SetClearTID(RegFile->RV64[10]);
 
-    /* TODO: Create a copy of Parents Memory Space (need Demand Paging first) */
+  /* rc = caller's TID */
+  RegFile->RV64[10] = CurrCtx->GetPID();
+  return RevProc::ECALL_status_t::SUCCESS;
+}
 
-    /*
-    * ===========================================================================================
-    * Register File
-    * ===========================================================================================
-    * We need to duplicate the parent's RegFile to to the Childs
-    * - NOTE: when we return from this function, the return value will
-    *         be automatically stored in the Proc.RegFile[HartToExec]'s a0
-    *         register. In a traditional fork code this looks like:
-    *
-    *         pid_t pid = fork()
-    *         if pid < 0: // Error
-    *         else if pid = 0: // New Child Process
-    *         else: // Parent Process
-    *
-    *         In this case, the value of pid is the value thats returned to a0
-    *         It follows that
-    *         - The child's regfile MUST have 0 in its a0 (despite its pid != 0 to the RevProc)
-    *         - The Parent's a0 register MUST have its PID in it
-    * ===========================================================================================
-    */
+/* ================================================================ */
+/* rev_futex(u32 *uaddr, int op, u32 val,                           */
+/*           struct __kernel_timespec *utime, u32 *uaddr2, u32 val3) */
+/* ================================================================ */
+RevProc::ECALL_status_t RevProc::ECALL_futex(RevInst& inst){
+  uint64_t Addr   = RegFile->RV64[10];
+  int Op          = (int)(RegFile->RV64[11]) & FUTEX_CMD_MASK;
+  uint32_t Val    = (uint32_t)(RegFile->RV64[12]);
+  uint64_t UTime  = RegFile->RV64[13];
+  uint32_t Bitset = (uint32_t)(RegFile->RV64[15]);
+  RevSyscallState &S = SyscallState();
+
+  switch( Op ){
+  case FUTEX_WAKE:
+    Bitset = FUTEX_BITSET_MATCH_ANY;
+    [[fallthrough]];
+  case FUTEX_WAKE_BITSET:
+    /* Without the scheduler nobody is ever parked */
+    RegFile->RV64[10] = Sched ? Sched->FutexWake(id, Addr, Val, Bitset) : 0;
+    return RevProc::ECALL_status_t::SUCCESS;
+  case FUTEX_WAIT:
+    Bitset = FUTEX_BITSET_MATCH_ANY;
+    [[fallthrough]];
+  case FUTEX_WAIT_BITSET:
+    if( Bitset == 0 ){
+      RegFile->RV64[10] = (uint64_t)(-EINVAL);
+      return RevProc::ECALL_status_t::SUCCESS;
+    }
+    break;
+  default:
+    output->verbose(CALL_INFO, 1, 0,
+                    "Warning: futex op %d is not supported\n", Op);
+    RegFile->RV64[10] = (uint64_t)(-ENOSYS);
+    return RevProc::ECALL_status_t::SUCCESS;
+  }
 
+  if( 0 == S.BytesRead ){
     /*
-    Alert the Proc there needs to be a Ctx switch
-    Pass the PID that will be switched to once the 
-    current pipeline is executed until completion
-    */
-    CtxSwitchAlert(ChildPID);
+     * Sample the wake sequence before reading the futex word; a wake
+     * that lands between the read and the park is caught by the
+     * scheduler instead of being lost
+     */
+    if( Sched )
+      S.FutexSeqNo = Sched->FutexSeq(Addr);
+    mem->ReadMem(HartToExec, Addr, sizeof(uint32_t), (void *)(S.Buf),
+                 inst.hazard, REVMEM_FLAGS(0x00));
+    S.BytesRead = sizeof(uint32_t);
+    return RevProc::ECALL_status_t::CONTINUE;
+  }
+  if( (UTime != 0) && (S.BytesRead == sizeof(uint32_t)) ){
+    /* struct __kernel_timespec { tv_sec, tv_nsec } */
+    mem->ReadMem(HartToExec, UTime, 2*sizeof(uint64_t), (void *)(&S.Buf[8]),
+                 inst.hazard, REVMEM_FLAGS(0x00));
+    S.BytesRead += 2*sizeof(uint64_t);
+    return RevProc::ECALL_status_t::CONTINUE;
+  }
+
+  uint32_t Word = 0;
+  uint64_t TimeSpec[2] = {0, 0};
+  std::memcpy(&Word, S.Buf, sizeof(Word));
+  if( UTime != 0 )
+    std::memcpy(TimeSpec, &S.Buf[8], sizeof(TimeSpec));
+
+  /*clean up ecall state*/
+  S.BytesRead = 0;
+  S.Buf[0] = '\0';
+
+  if( Word != Val ){
+    RegFile->RV64[10] = (uint64_t)(-EAGAIN);
+    return RevProc::ECALL_status_t::SUCCESS;
+  }
 
-    /* Parent's return value is the child's PID */
-    RegFile->RV64[10] = ChildPID;
+  /* a0 holds the result once the thread is woken (or times out) */
+  RegFile->RV64[10] = 0;
 
-    /* Child's return value is 0 */
-    ChildCtx->GetRegFile()->RV64[10] = 0;
+  if( !Sched ){
+    /*
+     * Pinned threads only switch on clone and exit, so nobody could
+     * wake us; report a spurious wakeup and let the caller re-check
+     */
+    return RevProc::ECALL_status_t::SUCCESS;
+  }
 
-    /*clean up ecall state*/
-    rtval = RevProc::ECALL_status_t::SUCCESS;
-    ECALL_bytesRead = 0;
-    ECALL_buf[0] = '\0';
+  /*
+   * FUTEX_WAIT timeouts are relative; FUTEX_WAIT_BITSET timeouts are
+   * absolute against a guest clock that starts with the simulation
+   */
+  uint64_t Deadline = 0;
+  if( UTime != 0 ){
+    uint64_t Cycles = Sched->ToCycles((TimeSpec[0]*1000000000ull) + TimeSpec[1]);
+    Deadline = (Op == FUTEX_WAIT) ? (SchedCycle + Cycles) : Cycles;
+    if( Deadline <= SchedCycle ){
+      RegFile->RV64[10] = (uint64_t)(-ETIMEDOUT);
+      return RevProc::ECALL_status_t::SUCCESS;
+    }
+  }
 
-  } //else
-  return rtval;
+  /* Park the thread once the ecall retires */
+  S.FutexBlocked = true;
+  S.FutexAddr = Addr;
+  S.FutexBitset = Bitset;
+  S.FutexDeadline = Deadline;
+  return RevProc::ECALL_status_t::SUCCESS;
 }
 
 
@@ -2772,26 +2975,27 @@ RevProc::ECALL_status_t RevProc::ECALL_clone(RevInst& inst){
 RevProc::ECALL_status_t RevProc::ECALL_chdir(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0, "ECALL_chdir called\n");
   RevProc::ECALL_status_t rtval = ECALL_status_t::SUCCESS;
+  RevSyscallState &S = SyscallState();
 
   // we don't know how long the path string is so read a byte (char)
   // at a time and search for the string terminator character '\0'
-  if('\0' != ECALL_buf[0]){
+  if('\0' != S.Buf[0]){
     //We are in the middle of the string
-    ECALL_string = ECALL_string + ECALL_buf[0];
-    mem->ReadVal<char>(HartToExec, RegFile->RV64[10] + sizeof(char)*ECALL_string.length(), &ECALL_buf[0], inst.hazard, REVMEM_FLAGS(0x00));
+    S.String = S.String + S.Buf[0];
+    mem->ReadVal<char>(HartToExec, RegFile->RV64[10] + sizeof(char)*S.String.length(), &S.Buf[0], inst.hazard, REVMEM_FLAGS(0x00));
     rtval = RevProc::ECALL_status_t::CONTINUE;
-  }else if(('\0' == ECALL_buf[0]) && (ECALL_string.length() > 0)) {
+  }else if(('\0' == S.Buf[0]) && (S.String.length() > 0)) {
     //found the null terminator - we're done
-    ECALL_string = ECALL_string + ECALL_buf[0];
-    const int rc = chdir(ECALL_string.data());
+    S.String = S.String + S.Buf[0];
+    const int rc = chdir(S.String.data());
     RegFile->RV64[10] = rc;
-    ECALL_string.clear();   //reset the ECALL buffers
-    ECALL_buf[0] = '\0';
+    S.String.clear();   //reset the ECALL buffers
+    S.Buf[0] = '\0';
     DependencyClear(HartToExec, 10, false);
     rtval = RevProc::ECALL_status_t::SUCCESS;
   }else{
     //first time through the ECALL
-    mem->ReadVal<char>(HartToExec, RegFile->RV64[10], &ECALL_buf[0], inst.hazard, REVMEM_FLAGS(0x00));
+    mem->ReadVal<char>(HartToExec, RegFile->RV64[10], &S.Buf[0], inst.hazard, REVMEM_FLAGS(0x00));
     rtval = RevProc::ECALL_status_t::CONTINUE;
     DependencySet(HartToExec, 10, false);
   }
@@ -2837,6 +3041,23 @@ RevProc::ECALL_status_t RevProc::ECALL_exit(RevInst& inst){
                     "Process %u exiting with status %lu\n",
                     CurrCtx->GetPID(), status );
     exit(status);
+  }
+
+  /* CLONE_CHILD_CLEARTID: tell a joining thread we are gone */
+  if( CurrCtx->GetClearTID() != 0 ){
+    uint32_t Zero = 0;
+    mem->WriteMem(HartToExec, CurrCtx->GetClearTID(), sizeof(Zero), &Zero);
+    if( Sched )
+      Sched->FutexWake(id, CurrCtx->GetClearTID(), 1, FUTEX_BITSET_MATCH_ANY);
+  }
+
+  if( Sched ){
+    /* The parent runs independently; release the core to the scheduler */
+    output->verbose(CALL_INFO, 0, 0,
+                    "Process %u exiting with status %lu\n",
+                    CurrCtx->GetPID(), status );
+    SetPC(0x00ull);
+    return RevProc::ECALL_status_t::SUCCESS;
   } else {
     /* Parent exists & Child is exiting... switch back to parent */
     CtxSwitchAlert(CurrCtx->GetParentPID());
@@ -2894,55 +3115,45 @@ RevProc::ECALL_status_t RevProc::ECALL_getppid(RevInst& inst){
 RevProc::ECALL_status_t RevProc::ECALL_write(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0, "ECALL_write called\n");
   int fildes = RegFile->RV64[10];
-  std::size_t nbytes = RegFile->RV64[12];
-
-  RevProc::ECALL_status_t rtv = RevProc::ECALL_status_t::SUCCESS;
-
-  if(ECALL_bytesRead == nbytes){
-    //Read is complete - send to host
-    ECALL_string = ECALL_string.append(ECALL_buf);
-    /* Perform the write on the host system */
-    const int rc = write(fildes, ECALL_string.data(), nbytes);
-
-    /* write returns the number of bytes written */
-    RegFile->RV64[10] = rc;
+  uint64_t BufAddr = RegFile->RV64[11];
+  uint64_t nbytes = RegFile->RV64[12];
+  RevSyscallState &S = SyscallState();
 
-    /*Reset our tracking state*/
-    ECALL_bytesRead = 0;
-    ECALL_buf[0] = '\0';
-    ECALL_string.clear();
-    rtv = RevProc::ECALL_status_t::SUCCESS;
+  if( nbytes > (uint64_t)(SSIZE_MAX) ){
+    RegFile->RV64[10] = (uint64_t)(-EINVAL);
     DependencyClear(HartToExec, 10, false);
+    return RevProc::ECALL_status_t::SUCCESS;
+  }
 
-  }else {
-    if(ECALL_bytesRead > 0){
-      //Not our first time through... so capture previous read data
-      ECALL_string = ECALL_string.append(ECALL_buf);
-    }
-    if(1 == (nbytes - ECALL_bytesRead)){
-      mem->ReadVal<char>(HartToExec, RegFile->RV64[11] + ECALL_bytesRead, ECALL_buf, inst.hazard, REVMEM_FLAGS(0x0));
-      ECALL_buf[1] = '\0';  //Pre-null terminate to allow for succesful string cat later
-      ECALL_bytesRead += sizeof(char);
-    }
-    else if(3 >= (nbytes - ECALL_bytesRead )){
-      mem->ReadVal<int16_t>(HartToExec, RegFile->RV64[11] + ECALL_bytesRead, reinterpret_cast<int16_t*>(ECALL_buf), inst.hazard, REVMEM_FLAGS(0x0));
-      ECALL_buf[2] = '\0'; //Pre-null terminate to allow for succesful string cat later
-      ECALL_bytesRead += sizeof(int16_t);
-    }
-    else if(7 >= (nbytes - ECALL_bytesRead )){
-      mem->ReadVal<int32_t>(HartToExec, RegFile->RV64[11] + ECALL_bytesRead, reinterpret_cast<int32_t*>(ECALL_buf), inst.hazard, REVMEM_FLAGS(0x0));
-      ECALL_buf[4] = '\0'; //Pre-null terminate to allow for succesful string cat later
-      ECALL_bytesRead += sizeof(int32_t);
-    }
-    else {
-      mem->ReadVal<int64_t>(HartToExec, RegFile->RV64[11] + ECALL_bytesRead, reinterpret_cast<int64_t*>(ECALL_buf), inst.hazard, REVMEM_FLAGS(0x0));
-      ECALL_buf[8] = '\0'; //Pre-null terminate to allow for succesful string cat later
-     ECALL_bytesRead += sizeof(int64_t);
-    }
-    rtv = RevProc::ECALL_status_t::CONTINUE;
-    DependencySet(HartToExec, 10, false);
+  /*
+   * Gather and write the guest buffer a bounded chunk at a time; under
+   * memHierarchy each chunk takes several passes
+   */
+  int Err = 0;
+  while( S.BulkProgress < nbytes ){
+    size_t Len = (size_t)(std::min<uint64_t>(nbytes - S.BulkProgress, _REV_BULK_CHUNK_));
+    if( !BulkRead(inst, BufAddr + S.BulkProgress, Len) ){
+      DependencySet(HartToExec, 10, false);
+      return RevProc::ECALL_status_t::CONTINUE;
+    }
+
+    /* Perform the write on the host system */
+    ssize_t rc = write(fildes, S.BulkBuf.data(), Len);
+    if( rc < 0 ){
+      Err = errno;
+      break;
+    }
+    S.BulkProgress += (uint64_t)(rc);
+    if( (size_t)(rc) < Len )
+      break;
   }
-  return rtv;
+  ChargeSyscall(inst);
+
+  /* write returns the number of bytes written; an error only if none were */
+  RegFile->RV64[10] = ((S.BulkProgress == 0) && Err) ? (uint64_t)(-Err) : S.BulkProgress;
+  S.BulkProgress = 0;
+  DependencyClear(HartToExec, 10, false);
+  return RevProc::ECALL_status_t::SUCCESS;
 }
 
 
@@ -3043,8 +3254,8 @@ RevProc::ECALL_status_t RevProc::ECALL_gettid(RevInst& inst){
   output->verbose(CALL_INFO, 2, 0, "ECALL: gettid called\n");
   RevRegFile* regFile = RegFile;
 
-  /* rc = Currently Executing Hart */
-  regFile->RV64[10] = HartToExec;
+  /* rc = PID of the Ctx executing on this Hart */
+  regFile->RV64[10] = ActivePIDs.at(HartToExec);
   return RevProc::ECALL_status_t::SUCCESS;
 }
 
@@ -3184,6 +3395,7 @@ RevProc::ECALL_status_t RevProc::ECALL_openat(RevInst& inst){
   uint64_t mode = RegFile->RV64[13];
 
   RevProc::ECALL_status_t rtval = ECALL_status_t::SUCCESS;
+  RevSyscallState &S = SyscallState();
   /*
    * NOTE: this is currently only opening files in the current directory
    *       because of some oddities in parsing the arguments & flags
@@ -3193,32 +3405,32 @@ RevProc::ECALL_status_t RevProc::ECALL_openat(RevInst& inst){
 
   /* Read the filename from memory one character at a time until we find '\0' */
 
-  if('\0' != ECALL_buf[0]){
+  if('\0' != S.Buf[0]){
     //We are in the middle of the string
-    ECALL_string = ECALL_string + ECALL_buf[0];
-    mem->ReadVal<char>(HartToExec, filenameAddr + sizeof(char)*ECALL_string.length(), &ECALL_buf[0], inst.hazard, REVMEM_FLAGS(0x00));
+    S.String = S.String + S.Buf[0];
+    mem->ReadVal<char>(HartToExec, filenameAddr + sizeof(char)*S.String.length(), &S.Buf[0], inst.hazard, REVMEM_FLAGS(0x00));
     rtval = RevProc::ECALL_status_t::CONTINUE;
     DependencySet(HartToExec, 10, false);
-  }else if(('\0' == ECALL_buf[0]) && (ECALL_string.length() > 0)) {
+  }else if(('\0' == S.Buf[0]) && (S.String.length() > 0)) {
     //found the null terminator - we're done
-    ECALL_string = ECALL_string + ECALL_buf[0];
+    S.String = S.String + S.Buf[0];
 
     /* Do the openat on the host */
     dfd = open(std::filesystem::current_path().c_str(), O_RDONLY);
-    int fd = openat(dfd, ECALL_string.c_str(), O_RDWR);
+    int fd = openat(dfd, S.String.c_str(), O_RDWR);
 
     HartToExecCtx()->AddFD(fd);
 
     /* openat returns the file descriptor of the opened file */
     RegFile->RV64[10] = fd;
 
-    ECALL_string.clear();   //reset the ECALL buffers
-    ECALL_buf[0] = '\0';
+    S.String.clear();   //reset the ECALL buffers
+    S.Buf[0] = '\0';
     rtval = RevProc::ECALL_status_t::SUCCESS;
     DependencyClear(HartToExec, 10, false);
   }else{
     //first time through the ECALL
-    mem->ReadVal<char>(HartToExec, filenameAddr, &ECALL_buf[0], inst.hazard, REVMEM_FLAGS(0x00));
+    mem->ReadVal<char>(HartToExec, filenameAddr, &S.Buf[0], inst.hazard, REVMEM_FLAGS(0x00));
     DependencySet(HartToExec, 10, false);
     rtval = RevProc::ECALL_status_t::CONTINUE;
   }
@@ -3233,37 +3445,134 @@ RevProc::ECALL_status_t RevProc::ECALL_read(RevInst& inst){
   int fd = RegFile->RV64[10];
   uint64_t BufAddr = RegFile->RV64[11];
   size_t BufSize = RegFile->RV64[12];
+  return ReadIntoGuest(inst, fd, BufAddr, BufSize, false, -1);
+}
+
+/* ============================================================================ */
+/* rev_readv(unsigned long fd, const struct iovec *vec, unsigned long vlen)     */
+/* ============================================================================ */
+RevProc::ECALL_status_t RevProc::ECALL_readv(RevInst& inst){
+  int fd = RegFile->RV64[10];
+  uint64_t VecAddr = RegFile->RV64[11];
+  uint64_t VecLen = RegFile->RV64[12];
+  return ReadIntoGuest(inst, fd, VecAddr, VecLen, true, -1);
+}
+
+/* ============================================================================ */
+/* rev_pread64(unsigned int fd, char *buf, size_t count, loff_t pos)            */
+/* ============================================================================ */
+RevProc::ECALL_status_t RevProc::ECALL_pread64(RevInst& inst){
+  int fd = RegFile->RV64[10];
+  uint64_t BufAddr = RegFile->RV64[11];
+  size_t BufSize = RegFile->RV64[12];
+  int64_t Pos = (int64_t)(RegFile->RV64[13]);
+  if( Pos < 0 ){
+    RegFile->RV64[10] = (uint64_t)(-EINVAL);
+    return RevProc::ECALL_status_t::SUCCESS;
+  }
+  return ReadIntoGuest(inst, fd, BufAddr, BufSize, false, Pos);
+}
+
+/* ============================================================================ */
+/* rev_preadv(unsigned long fd, const struct iovec *vec, unsigned long vlen,    */
+/*            unsigned long pos_l, unsigned long pos_h)                          */
+/* ============================================================================ */
+RevProc::ECALL_status_t RevProc::ECALL_preadv(RevInst& inst){
+  int fd = RegFile->RV64[10];
+  uint64_t VecAddr = RegFile->RV64[11];
+  uint64_t VecLen = RegFile->RV64[12];
+  /* pos_l holds the whole offset on rv64; pos_h only matters on rv32 */
+  int64_t Pos = (int64_t)(RegFile->RV64[13]);
+  if( Pos < 0 ){
+    RegFile->RV64[10] = (uint64_t)(-EINVAL);
+    return RevProc::ECALL_status_t::SUCCESS;
+  }
+  return ReadIntoGuest(inst, fd, VecAddr, VecLen, true, Pos);
+}
 
+RevProc::ECALL_status_t RevProc::ReadIntoGuest(RevInst& inst, int fd, uint64_t Buf,
+                                                uint64_t Count, bool Vec, int64_t Pos){
   /* Check if Current Ctx has access to the fd */
   std::shared_ptr<RevThreadCtx> CurrCtx = HartToExecCtx();
 
   if( !CurrCtx->FindFD(fd) ){
-    output->fatal(CALL_INFO, -1,
-                  "Core %d; Hart %d; PID %" PRIu32 " tried to read from file descriptor: %" PRIu64 " but did not have access to it\n",
-                  id, HartToExec, HartToExecPID(), fd);
+    /* an unknown or closed fd is the guest's error to handle, as on Linux */
+    output->verbose(CALL_INFO, 2, 0,
+                    "Core %d; Hart %d; PID %" PRIu32 " tried to read from file descriptor: %d but did not have access to it\n",
+                    id, HartToExec, HartToExecPID(), fd);
+    RegFile->RV64[10] = (uint64_t)(-EBADF);
+    DependencyClear(HartToExec, 10, false);
     return RevProc::ECALL_status_t::SUCCESS;
   }
-  /*
-   * This buffer is an intermediate buffer for storing the data read from host 
-   * for later use in writing to RevMem
-  */
-  char TmpBuf[BufSize];
 
-  /*
-   * Read nbytes of fd from host
-   *
-   * NOTE: Because the fd is in the Ctx's fildes vector, we can reasonably
-   *       assume the file is already open on the host system because we 
-   *       try to maintain parity between those
-   */
+  /* Segments of guest memory to fill: { iov_base, iov_len } */
+  std::vector<std::pair<uint64_t, uint64_t>> Segs;
+  if( Vec ){
+    /* UIO_MAXIOV */
+    if( Count > 1024 ){
+      RegFile->RV64[10] = (uint64_t)(-EINVAL);
+      return RevProc::ECALL_status_t::SUCCESS;
+    }
+    /* Gather the guest iovec array; under memHierarchy this takes several passes */
+    if( !BulkRead(inst, Buf, Count*2*sizeof(uint64_t)) ){
+      DependencySet(HartToExec, 10, false);
+      return RevProc::ECALL_status_t::CONTINUE;
+    }
+    for( uint64_t i=0; i<Count; i++ ){
+      uint64_t Iov[2];
+      std::memcpy(Iov, &CurrCtx->GetSyscallState().BulkBuf[i*sizeof(Iov)], sizeof(Iov));
+      Segs.emplace_back(Iov[0], Iov[1]);
+    }
+  }else{
+    Segs.emplace_back(Buf, Count);
+  }
 
-  /* Do the read on the host */
-  uint64_t rc = read(fd, &TmpBuf, BufSize);
+  /* The guest controls the lengths; the total must fit in a ssize_t */
+  uint64_t Total = 0;
+  for( auto &S : Segs ){
+    if( S.second > ((uint64_t)(SSIZE_MAX) - Total) ){
+      RegFile->RV64[10] = (uint64_t)(-EINVAL);
+      DependencyClear(HartToExec, 10, false);
+      return RevProc::ECALL_status_t::SUCCESS;
+    }
+    Total += S.second;
+  }
 
-  /* Write that data to the buffer inside of Rev */
-  mem->WriteMem(feature->GetHart(), BufAddr, BufSize, &TmpBuf);
+  /*
+   * Read from the host a bounded chunk at a time and scatter each chunk
+   * into the guest segments, stopping at EOF or a short read.  The fd is
+   * in the Ctx's fildes vector, so we can assume it is open on the host
+   * system because we try to maintain parity between those
+   */
+  std::vector<char> Data((size_t)(std::min<uint64_t>(Total, _REV_BULK_CHUNK_)));
+  uint64_t Off = 0;
+  bool Untimed = true;
+  int Err = 0;
+  for( auto &S : Segs ){
+    uint64_t SegOff = 0;
+    while( SegOff < S.second ){
+      size_t Len = (size_t)(std::min<uint64_t>(S.second - SegOff, _REV_BULK_CHUNK_));
+      ssize_t rc = (Pos < 0) ? read(fd, Data.data(), Len)
+                             : pread(fd, Data.data(), Len, (off_t)(Pos + Off));
+      if( rc < 0 ){
+        Err = errno;
+        break;
+      }
+      Untimed &= BulkWrite(S.first + SegOff, Data.data(), (size_t)(rc));
+      SegOff += (uint64_t)(rc);
+      Off += (uint64_t)(rc);
+      if( (size_t)(rc) < Len )
+        break;
+    }
+    if( Err || (SegOff < S.second) )
+      break;
+  }
+  ChargeBulk(inst, (size_t)(Off), Untimed);
+  ChargeSyscall(inst);
 
-  RegFile->RV64[10] = rc;
+  /* an error is only reported if nothing was read */
+  RegFile->RV64[10] = ((Off == 0) && Err) ? (uint64_t)(-Err) : Off;
+  DependencyClear(HartToExec, 10, false);
   return RevProc::ECALL_status_t::SUCCESS;
 }
 
@@ -3320,28 +3629,29 @@ RevProc::ECALL_status_t RevProc::ECALL_mkdirat(RevInst& inst){
   unsigned fd = RegFile->RV64[10];
   unsigned Mode = RegFile->RV64[12];
   RevProc::ECALL_status_t rtval = ECALL_status_t::SUCCESS;
+  RevSyscallState &S = SyscallState();
 
-  if('\0' != ECALL_buf[0]){
+  if('\0' != S.Buf[0]){
     //We are in the middle of the string
-    ECALL_string = ECALL_string + ECALL_buf[0];
-    mem->ReadVal<char>(HartToExec, RegFile->RV64[11] + sizeof(char)*ECALL_string.length(), &ECALL_buf[0], inst.hazard, REVMEM_FLAGS(0x00));
+    S.String = S.String + S.Buf[0];
+    mem->ReadVal<char>(HartToExec, RegFile->RV64[11] + sizeof(char)*S.String.length(), &S.Buf[0], inst.hazard, REVMEM_FLAGS(0x00));
     rtval = RevProc::ECALL_status_t::CONTINUE;
     DependencySet(HartToExec, 10, false);
-  }else if(('\0' == ECALL_buf[0]) && (ECALL_string.length() > 0)) {
+  }else if(('\0' == S.Buf[0]) && (S.String.length() > 0)) {
     //found the null terminator - we're done
-    ECALL_string = ECALL_string + ECALL_buf[0];
+    S.String = S.String + S.Buf[0];
 
     /* Do the mkdirat on the host */
-    const int rc = mkdirat(fd, ECALL_string.data(), Mode);
+    const int rc = mkdirat(fd, S.String.data(), Mode);
     RegFile->RV64[10] = rc;
 
-    ECALL_string.clear();   //reset the ECALL buffers
-    ECALL_buf[0] = '\0';
+    S.String.clear();   //reset the ECALL buffers
+    S.Buf[0] = '\0';
     rtval = RevProc::ECALL_status_t::SUCCESS;
     DependencyClear(HartToExec, 10, false);
   }else{
     //first time through the ECALL
-    mem->ReadVal<char>(HartToExec, RegFile->RV64[11], &ECALL_buf[0], inst.hazard, REVMEM_FLAGS(0x00));
+    mem->ReadVal<char>(HartToExec, RegFile->RV64[11], &S.Buf[0], inst.hazard, REVMEM_FLAGS(0x00));
     DependencySet(HartToExec, 10, false);
     rtval = RevProc::ECALL_status_t::CONTINUE;
   }
@@ -3383,9 +3693,278 @@ RevProc::ECALL_status_t RevProc::ECALL_dup(RevInst& inst){
 }
 
 
+bool RevProc::IsMemoryBlocked(){
+  if( PendingCtxSwitch || Halted || Draining || SchedIdle )
+    return false;
+
+  uint64_t PC = GetPC();
+  if( (PC == 0x00ull) || (PC == _PAN_FWARE_JUMP_) )
+    return false;
+
+  if( Pipeline.empty() ){
+    // the next fetch stalls until the stream fill returns
+    BlockedFetch = true;
+    return (RegFile->cost == 0) && sfetch->IsWaiting(PC);
+  }
+
+  // the front instruction holds its cost until the load hazard
+  // clears; fetch and execute have nothing to do in the meantime
+  BlockedFetch = false;
+  bool ExecIdle = !((HartToExec != _REV_INVALID_HART_ID_) && !RegFile->trigger &&
+                    HART_CTE[HartToExec]);
+  return (RegFile->cost != 0) && ExecIdle &&
+         (Pipeline.front().second.cost > 0) && *(Pipeline.front().second.hazard);
+}
+
+void RevProc::AccountIdle( uint64_t Cycles ){
+  // mirror the per-cycle accounting of ClockTick for the blocked state
+  Stats.totalCycles += Cycles;
+  Stats.cyclesIdle_Total += Cycles;
+  if( BlockedFetch ){
+    Stats.cyclesStalled += Cycles;
+    Stats.cyclesIdle_Pipeline += Cycles;
+  }else if( HART_CTE.any() ){
+    Stats.cyclesIdle_MemoryFetch += Cycles;
+  }
+}
+
+bool RevProc::SchedTick( SST::Cycle_t currentCycle ){
+  // futex deadlines use the component clock, which every core shares,
+  // so a waiter may time out on a different core than it parked on
+  SchedCycle = currentCycle;
+  Sched->FutexExpire(id, SchedCycle);
+
+  // a finished thread holds the core until the loads and bulk copies
+  // targeting its context have landed.  other cores' traffic does not
+  // hold it up, except for the last thread: the simulation ends with
+  // it, so its posted writes must drain first
+  if( !SchedIdle && (GetPC() == 0x00ull) && Pipeline.empty() ){
+    if( !LoadHazards.empty() || HartCtx[HartToDecode]->GetSyscallState().BulkActive )
+      return false;
+    if( Sched->IsLast() && mem->outstandingRqsts() )
+      return false;
+    RetireThread();
+  }
+
+  // a thread blocked in futex wait leaves the core once the ecall retires
+  if( !SchedIdle && Pipeline.empty() &&
+      HartCtx[HartToDecode]->GetSyscallState().FutexBlocked ){
+    RevSyscallState &S = HartCtx[HartToDecode]->GetSyscallState();
+    S.FutexBlocked = false;
+    if( Sched->FutexPark(S.FutexAddr, S.FutexSeqNo, S.FutexBitset, S.FutexDeadline,
+                         HartCtx[HartToDecode]) ){
+      output->verbose(CALL_INFO, 2, 0, "Core %d ; Thread %u waiting on futex 0x%" PRIx64 "\n",
+                      id, ActivePIDs.at(HartToDecode), S.FutexAddr);
+      SchedIdle = true;
+    }
+  }
+
+  if( SchedIdle ){
+    std::shared_ptr<RevThreadCtx> Ctx = Sched->Next(id);
+    if( !Ctx ){
+      if( Sched->Deadlocked() )
+        output->fatal(CALL_INFO, -1,
+                      "Error: every guest thread is blocked in futex wait\n");
+      return false;
+    }
+    LoadThread(Ctx);
+    return true;
+  }
+
+  // preempt the thread between instructions once its quantum expires
+  // and another waits.  a multi-pass ecall may be switched out between
+  // passes: its progress lives in the thread context and resumes when
+  // the rewound ecall is fetched again, on whichever core runs it next
+  SliceCycles++;
+  const uint64_t Quantum = Sched->GetQuantum();
+  const bool Quiesced = ((RegFile->RV64_SCAUSE == 0) ||
+                         (RegFile->RV64_SCAUSE == ECALL_status_t::CONTINUE)) &&
+                        ((RegFile->RV32_SCAUSE == 0) ||
+                         (RegFile->RV32_SCAUSE == ECALL_status_t::CONTINUE));
+  if( (Quantum > 0) && (SliceCycles >= Quantum) && Pipeline.empty() &&
+      (RegFile->cost == 0) && Quiesced && Sched->HasWaiting() ){
+    std::shared_ptr<RevThreadCtx> Ctx = Sched->Next(id);
+    if( Ctx ){
+      Sched->Yield(id, HartCtx[HartToDecode]);
+      LoadThread(Ctx);
+    }else{
+      SliceCycles = 0;
+    }
+  }
+  return true;
+}
+
+void RevProc::LoadThread(std::shared_ptr<RevThreadCtx> Ctx){
+  // the previous thread is either finished or back in a run queue
+  output->verbose(CALL_INFO, 2, 0, "Core %d ; Loading thread with PID = %u\n",
+                  id, Ctx->GetPID());
+  ThreadTable.erase(ActivePIDs.at(HartToDecode));
+  ThreadTable.emplace(Ctx->GetPID(), Ctx);
+  // reservations are keyed by core; the incoming thread never took one
+  mem->ClearReservation(feature->GetHart());
+  BindHart(HartToDecode, Ctx);
+  UpdateRegFile();
+  RegFile->trigger = 0;
+  RegFile->cost = 0;
+  ExecPC = GetPC();
+  SchedIdle = false;
+  SliceCycles = 0;
+}
+
+void RevProc::RetireThread(){
+  uint32_t PID = ActivePIDs.at(HartToDecode);
+  output->verbose(CALL_INFO, 2, 0, "Thread %u completed execution.\n", PID);
+  HartCtx[HartToDecode]->SetState(ThreadState::Dead);
+  Sched->Exit();
+  SchedIdle = true;
+}
+
+bool RevProc::FastForward( uint64_t Count, uint64_t StopPC, bool UntilMarker,
+                           uint64_t &Executed ){
+  Executed = 0;
+  bool Hazard = false;
+
+  while( Executed < Count ){
+    // resolve context switches raised by the previous ecall immediately;
+    // there is never anything in flight
+    if( PendingCtxSwitch ){
+      if( !ChangeActivePID(NextPID) ){
+        output->fatal(CALL_INFO, -1,
+                      "Core %d ; Hart %u; PID %d Failed to change active PID to %u\n",
+                      id, HartToDecode, GetActivePID(), NextPID);
+      }
+      PendingCtxSwitch = false;
+      NextPID = 0;
+    }
+
+    uint64_t PC = GetPC();
+    if( PC == StopPC )
+      return true;
+
+    // thread completion and PAN work dispatch are left to the timed path
+    if( (PC == 0x00ull) || (PC == _PAN_FWARE_JUMP_) || Halted )
+      return false;
+
+    // without memHierarchy the stream fill completes immediately,
+    // so the second probe always hits and the prefetcher stays warm
+    if( !sfetch->IsAvail(PC) && !sfetch->IsAvail(PC) ){
+      output->fatal(CALL_INFO, -1,
+                    "Error: fast-forward failed to fetch the instruction at PC=0x%" PRIx64 "\n",
+                    PC);
+    }
+
+    RevInst FInst = DecodeInst();
+    FInst.entry = RegFile->Entry;
+    FInst.hazard = &Hazard;
+    ExecPC = PC;
+
+    if( !ITab->InstTable[FInst.entry].func(feature, RegFile, mem, FInst) ){
+      output->fatal(CALL_INFO, -1,
+                    "Error: failed to execute instruction at PC=%" PRIx64 ".", PC );
+    }
+
+    if( (RegFile->RV64_SCAUSE == EXCEPTION_CAUSE::ECALL_USER_MODE) ||
+        (RegFile->RV32_SCAUSE == EXCEPTION_CAUSE::ECALL_USER_MODE) ){
+      ExecEcall(FInst);
+    }
+
+    // functional execution never waits on the cost or the scoreboard
+    RegFile->cost = 0;
+    RegFile->trigger = false;
+    Executed++;
+    Retired++;
+
+    if( UntilMarker && !FInst.compressed && (FInst.opcode == 0b0010011) &&
+        (FInst.funct3 == 0) && (FInst.rd == 0) && (FInst.rs1 == 0) &&
+        (FInst.imm == _REV_FF_MARKER_IMM_) )
+      return true;
+  }
+
+  return false;
+}
+
+bool RevProc::BulkRead(RevInst& inst, uint64_t Addr, size_t Len){
+  // the copy belongs to the executing thread; its line reads land in
+  // the thread's own buffer even if the thread is switched out
+  RevSyscallState &S = SyscallState();
+  if( !S.BulkActive ){
+    S.BulkBuf.resize(Len);
+
+    // without memHierarchy copy straight from the backing store in a
+    // single pass and charge the modeled cost to the ecall instead
+    if( (Len == 0) || mem->ReadBulk(Addr, Len, S.BulkBuf.data()) ){
+      ChargeBulk(inst, Len, true);
+      return true;
+    }
+
+    // memHierarchy owns the data; gather it with pipelined line reads
+    uint64_t Line = mem->getLineSize();
+    S.BulkLines = (size_t)(((Addr+Len-1)/Line) - (Addr/Line) + 1);
+    S.BulkHazard.reset(new bool[S.BulkLines]());
+    S.BulkIssued = 0;
+    S.BulkDone = 0;
+    S.BulkOff = 0;
+    S.BulkActive = true;
+  }
+
+  // retire the completed reads in order, then top up the window
+  while( (S.BulkDone < S.BulkIssued) && !S.BulkHazard[S.BulkDone] )
+    S.BulkDone++;
+
+  uint64_t Line = mem->getLineSize();
+  while( (S.BulkIssued < S.BulkLines) && ((S.BulkIssued - S.BulkDone) < _REV_BULK_INFLIGHT_) ){
+    uint64_t A = Addr + S.BulkOff;
+    uint64_t Chunk = Line - (A % Line);
+    if( Chunk > (Len - S.BulkOff) )
+      Chunk = Len - S.BulkOff;
+    mem->ReadMem(HartToExec, A, (size_t)(Chunk), (void *)(&S.BulkBuf[S.BulkOff]),
+                 &S.BulkHazard[S.BulkIssued], REVMEM_FLAGS(0x00));
+    S.BulkOff += Chunk;
+    S.BulkIssued++;
+  }
+
+  if( S.BulkDone < S.BulkLines )
+    return false;
+
+  S.BulkHazard.reset();
+  S.BulkActive = false;
+  ChargeBulk(inst, Len, false);
+  return true;
+}
+
+bool RevProc::BulkWrite(uint64_t Addr, const char *Data, size_t Len){
+  if( (Len == 0) || mem->WriteBulk(Addr, Len, Data) )
+    return true;
+
+  // memHierarchy owns the data; writes are posted and capture their
+  // payload when sent, so every line goes out in this pass
+  uint64_t Line = mem->getLineSize();
+  uint64_t Off = 0;
+  while( Off < Len ){
+    uint64_t A = Addr + Off;
+    uint64_t Chunk = Line - (A % Line);
+    if( Chunk > (Len - Off) )
+      Chunk = Len - Off;
+    mem->WriteMem(HartToExec, A, (size_t)(Chunk), (void *)(&Data[Off]));
+    Off += Chunk;
+  }
+  return false;
+}
+
+void RevProc::ChargeBulk(RevInst& inst, size_t Len, bool Untimed){
+  // memHierarchy times the transfer itself; otherwise model the bandwidth
+  if( Untimed && (SyscallBPC > 0) )
+    inst.cost += (uint32_t)((Len + SyscallBPC - 1) / SyscallBPC);
+}
+
+void RevProc::ChargeSyscall(RevInst& inst){
+  // the fixed cost is paid once per syscall, however many copies it makes
+  inst.cost += (uint32_t)(SyscallLatency);
+}
+
 /*
  * This is the function that is called when an ECALL exception is detected inside ClockTick
- * - Currently the only way to set this exception is by Ext->Execute(....) an ECALL instruction
+ * - Currently the only way to set this exception is by executing an ECALL instruction
  *
  * Eventually this will be integrated into a TrapHandler however since ECALLs are the only
  * supported exceptions at this point there is no need just yet.
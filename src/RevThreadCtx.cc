@@ -12,6 +12,9 @@
 #include "../include/RevThreadCtx.h"
 #include <algorithm>
 #include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
 
 bool RevThreadCtx::AddChildPID(uint32_t pid){
   if( std::find(ChildrenPIDs.begin(), ChildrenPIDs.end(), pid) != ChildrenPIDs.end() ){
@@ -94,4 +97,103 @@ bool RevThreadCtx::RemoveFD(int fd){
   return false;  
 }
 
+/* Write the Ctx to a checkpoint */
+bool RevThreadCtx::DumpCtx(std::ostream &os){
+  RevSnapshot::Put<uint32_t>(os, PID);
+  RevSnapshot::Put<uint32_t>(os, ParentPID);
+  RevSnapshot::Put<uint32_t>(os, (uint32_t)(State));
+  os.write((const char *)(&RegFile), sizeof(RevRegFile));
+  RevSnapshot::Put<uint64_t>(os, ClearTID);
 
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(ChildrenPIDs.size()));
+  for( auto C : ChildrenPIDs ){
+    RevSnapshot::Put<uint32_t>(os, C);
+  }
+
+  /*
+   * Guest fds are host fds; record enough to reopen them at the
+   * same number (path, access flags and file offset)
+   */
+  RevSnapshot::Put<uint64_t>(os, (uint64_t)(fildes.size()));
+  for( auto fd : fildes ){
+    std::string Path;
+    int64_t Offset = 0;
+    int Flags = 0;
+    if( fd > 2 ){
+      char Link[PATH_MAX];
+      std::string Proc = "/proc/self/fd/" + std::to_string(fd);
+      ssize_t n = readlink(Proc.c_str(), Link, sizeof(Link)-1);
+      if( n > 0 )
+        Path.assign(Link, n);
+      Offset = (int64_t)(lseek(fd, 0, SEEK_CUR));
+      Flags = fcntl(fd, F_GETFL);
+    }
+    RevSnapshot::Put<int32_t>(os, fd);
+    RevSnapshot::PutStr(os, Path);
+    RevSnapshot::Put<int64_t>(os, Offset);
+    RevSnapshot::Put<int32_t>(os, Flags);
+  }
+  return os.good();
+}
+
+/* Restore the Ctx from a checkpoint */
+bool RevThreadCtx::RestoreCtx(const char *Buf, size_t Len, size_t &Off,
+                              std::set<int> &Reopened){
+  uint32_t TmpState = 0;
+  if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, PID) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, ParentPID) ||
+      !RevSnapshot::Get<uint32_t>(Buf, Len, Off, TmpState) ||
+      (sizeof(RevRegFile) > (Len - Off)) )
+    return false;
+  State = (ThreadState)(TmpState);
+  std::memcpy((void *)(&RegFile), &Buf[Off], sizeof(RevRegFile));
+  Off += sizeof(RevRegFile);
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, ClearTID) )
+    return false;
+
+  uint64_t N = 0;
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, N) )
+    return false;
+  ChildrenPIDs.clear();
+  for( uint64_t i=0; i<N; i++ ){
+    uint32_t C = 0;
+    if( !RevSnapshot::Get<uint32_t>(Buf, Len, Off, C) )
+      return false;
+    ChildrenPIDs.push_back(C);
+  }
+
+  if( !RevSnapshot::Get<uint64_t>(Buf, Len, Off, N) )
+    return false;
+  fildes.clear();
+  for( uint64_t i=0; i<N; i++ ){
+    int32_t fd = 0;
+    std::string Path;
+    int64_t Offset = 0;
+    int32_t Flags = 0;
+    if( !RevSnapshot::Get<int32_t>(Buf, Len, Off, fd) ||
+        !RevSnapshot::GetStr(Buf, Len, Off, Path) ||
+        !RevSnapshot::Get<int64_t>(Buf, Len, Off, Offset) ||
+        !RevSnapshot::Get<int32_t>(Buf, Len, Off, Flags) )
+      return false;
+
+    /* fds shared between Ctxs are only reopened once */
+    if( (fd > 2) && !Path.empty() && (Reopened.find(fd) == Reopened.end()) ){
+      int NewFD = open(Path.c_str(), Flags & (O_ACCMODE | O_APPEND));
+      if( NewFD < 0 )
+        return false;
+      if( NewFD != fd ){
+        /* never clobber a descriptor owned by the simulator */
+        if( fcntl(fd, F_GETFD) != -1 ){
+          close(NewFD);
+          return false;
+        }
+        dup2(NewFD, fd);
+        close(NewFD);
+      }
+      lseek(fd, (off_t)(Offset), SEEK_SET);
+      Reopened.insert(fd);
+    }
+    fildes.push_back(fd);
+  }
+  return true;
+}
@@ -0,0 +1,79 @@
+//
+// _RevThreadPool_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevThreadPool.h"
+
+using namespace SST;
+using namespace RevCPU;
+
+RevThreadPool::RevThreadPool( unsigned Threads )
+  : numThreads(Threads), job(nullptr), generation(0), pending(0),
+    shutdown(false){
+  if( numThreads == 0 )
+    numThreads = 1;
+  workers.reserve(numThreads-1);
+  for( unsigned i=1; i<numThreads; i++ ){
+    workers.emplace_back(&RevThreadPool::Worker, this, i);
+  }
+}
+
+RevThreadPool::~RevThreadPool(){
+  {
+    std::lock_guard<std::mutex> Lock(mtx);
+    shutdown = true;
+  }
+  startCV.notify_all();
+  for( auto &W : workers ){
+    W.join();
+  }
+}
+
+void RevThreadPool::Run( const std::function<void(unsigned)> &Job ){
+  {
+    std::lock_guard<std::mutex> Lock(mtx);
+    job = &Job;
+    pending = numThreads-1;
+    generation++;
+  }
+  startCV.notify_all();
+
+  // the caller takes the first slice
+  Job(0);
+
+  std::unique_lock<std::mutex> Lock(mtx);
+  doneCV.wait(Lock, [this]{ return pending == 0; });
+  job = nullptr;
+}
+
+void RevThreadPool::Worker( unsigned Idx ){
+  uint64_t Seen = 0;
+  while( true ){
+    const std::function<void(unsigned)> *J = nullptr;
+    {
+      std::unique_lock<std::mutex> Lock(mtx);
+      startCV.wait(Lock, [this,Seen]{ return shutdown || (generation != Seen); });
+      if( shutdown )
+        return ;
+      Seen = generation;
+      J = job;
+    }
+
+    (*J)(Idx);
+
+    {
+      std::lock_guard<std::mutex> Lock(mtx);
+      pending--;
+      if( pending == 0 )
+        doneCV.notify_one();
+    }
+  }
+}
+
+// EOF
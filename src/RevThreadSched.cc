@@ -0,0 +1,211 @@
+//
+// _RevThreadSched_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevThreadSched.h"
+#include <cerrno>
+
+using namespace SST;
+using namespace RevCPU;
+
+RevThreadSched::RevThreadSched( unsigned NumCores, uint64_t Quantum, bool Steal,
+                                uint64_t CyclePS )
+  : quantum(Quantum), steal(Steal), runQ(NumCores ? NumCores : 1),
+    live(1), waiting(0), spawned(0), steals(0), preemptions(0),
+    cyclePS(CyclePS ? CyclePS : 1), parked(0),
+    futexSeq(_REV_FUTEX_SEQ_BUCKETS_, 0), nextDeadline(UINT64_MAX),
+    awaiting(false){
+  // the initial (root) thread is live from the start
+}
+
+unsigned RevThreadSched::Place( unsigned Core ){
+  if( steal )
+    return Core;
+
+  // nobody will come looking for it; place it on the least loaded
+  // core, preferring the cores after the (busy) creating core
+  unsigned Target = (Core+1) % runQ.size();
+  for( unsigned i=2; i<=runQ.size(); i++ ){
+    unsigned C = (Core+i) % runQ.size();
+    if( runQ[C].size() < runQ[Target].size() )
+      Target = C;
+  }
+  return Target;
+}
+
+void RevThreadSched::Ready( unsigned Core, std::shared_ptr<RevThreadCtx> Ctx ){
+  Ctx->SetState(ThreadState::Waiting);
+  runQ[Place(Core)].push_back(Ctx);
+  waiting++;
+}
+
+void RevThreadSched::Spawn( unsigned Core, std::shared_ptr<RevThreadCtx> Ctx ){
+  // an exported thread lives and dies on the component that took it
+  if( exportFn && exportFn(Ctx) ){
+    std::lock_guard<std::mutex> Lock(mtx);
+    spawned++;
+    return ;
+  }
+
+  std::lock_guard<std::mutex> Lock(mtx);
+  Ready(Core, Ctx);
+  live++;
+  spawned++;
+}
+
+void RevThreadSched::AwaitRemote(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  if( live > 0 )
+    live--;
+  awaiting = true;
+}
+
+void RevThreadSched::Release(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  awaiting = false;
+}
+
+void RevThreadSched::Yield( unsigned Core, std::shared_ptr<RevThreadCtx> Ctx ){
+  std::lock_guard<std::mutex> Lock(mtx);
+  Ctx->SetState(ThreadState::Waiting);
+  runQ[Core].push_back(Ctx);
+  waiting++;
+  preemptions++;
+}
+
+std::shared_ptr<RevThreadCtx> RevThreadSched::Next( unsigned Core ){
+  std::lock_guard<std::mutex> Lock(mtx);
+  unsigned Victim = Core;
+  if( runQ[Core].empty() ){
+    if( !steal )
+      return nullptr;
+    for( unsigned i=1; i<runQ.size(); i++ ){
+      unsigned C = (Core+i) % runQ.size();
+      if( runQ[C].size() > runQ[Victim].size() )
+        Victim = C;
+    }
+    if( runQ[Victim].empty() )
+      return nullptr;
+    steals++;
+  }
+
+  std::shared_ptr<RevThreadCtx> Ctx = runQ[Victim].front();
+  runQ[Victim].pop_front();
+  Ctx->SetState(ThreadState::Running);
+  waiting--;
+  return Ctx;
+}
+
+void RevThreadSched::Exit(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  if( live > 0 )
+    live--;
+}
+
+bool RevThreadSched::HasWaiting(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  return waiting > 0;
+}
+
+bool RevThreadSched::Done(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  return (live == 0) && !awaiting;
+}
+
+bool RevThreadSched::IsLast(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  return live == 1;
+}
+
+uint64_t RevThreadSched::FutexSeq( uint64_t Addr ){
+  std::lock_guard<std::mutex> Lock(mtx);
+  return SeqOf(Addr);
+}
+
+bool RevThreadSched::FutexPark( uint64_t Addr, uint64_t Seq, uint32_t Bitset,
+                                uint64_t Deadline, std::shared_ptr<RevThreadCtx> Ctx ){
+  std::lock_guard<std::mutex> Lock(mtx);
+
+  // a wake issued after the waiter sampled the word may have changed
+  // it; the waiter returns as if it had been woken.  the sequence is
+  // shared by a bucket of words, so a wake of another word in the
+  // bucket yields a (permitted) spurious wakeup
+  if( SeqOf(Addr) != Seq )
+    return false;
+
+  Ctx->SetState(ThreadState::Sleeping);
+  futex[Addr].Waiters.push_back({Ctx, Bitset, Deadline});
+  parked++;
+  if( (Deadline != 0) && (Deadline < nextDeadline) )
+    nextDeadline = Deadline;
+  return true;
+}
+
+unsigned RevThreadSched::FutexWake( unsigned Core, uint64_t Addr, unsigned Count, uint32_t Bitset ){
+  std::lock_guard<std::mutex> Lock(mtx);
+  SeqOf(Addr)++;
+
+  auto F = futex.find(Addr);
+  if( F == futex.end() )
+    return 0;
+
+  FutexQueue &Q = F->second;
+  unsigned Woken = 0;
+  auto it = Q.Waiters.begin();
+  while( (it != Q.Waiters.end()) && (Woken < Count) ){
+    if( (it->Bitset & Bitset) == 0 ){
+      it++;
+      continue;
+    }
+    // the waiter's a0 already holds 0 from its futex wait
+    Ready(Core, it->Ctx);
+    it = Q.Waiters.erase(it);
+    parked--;
+    Woken++;
+  }
+  if( Q.Waiters.empty() )
+    futex.erase(F);
+  return Woken;
+}
+
+void RevThreadSched::FutexExpire( unsigned Core, uint64_t Now ){
+  if( Now < nextDeadline )
+    return ;
+
+  std::lock_guard<std::mutex> Lock(mtx);
+  uint64_t Next = UINT64_MAX;
+  auto F = futex.begin();
+  while( F != futex.end() ){
+    auto it = F->second.Waiters.begin();
+    while( it != F->second.Waiters.end() ){
+      if( (it->Deadline == 0) || (it->Deadline > Now) ){
+        if( (it->Deadline != 0) && (it->Deadline < Next) )
+          Next = it->Deadline;
+        it++;
+        continue;
+      }
+      it->Ctx->GetRegFile()->RV64[10] = (uint64_t)(-ETIMEDOUT);
+      Ready(Core, it->Ctx);
+      it = F->second.Waiters.erase(it);
+      parked--;
+    }
+    if( F->second.Waiters.empty() )
+      F = futex.erase(F);
+    else
+      F++;
+  }
+  nextDeadline = Next;
+}
+
+bool RevThreadSched::Deadlocked(){
+  std::lock_guard<std::mutex> Lock(mtx);
+  return (parked > 0) && (live == parked) && (nextDeadline == UINT64_MAX);
+}
+
+// EOF
@@ -0,0 +1,57 @@
+/*
+ * checkpoint.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define N 4096
+#define ROUNDS 4
+
+long data[N];
+
+// print the digest as "checkpoint digest: 0x<16 hex digits>"
+static void print_digest(unsigned long d){
+  char line[] = "checkpoint digest: 0x0000000000000000\n";
+  const char hex[] = "0123456789abcdef";
+  int i = 0;
+  for( i=0; i<16; i++ ){
+    line[21+15-i] = hex[d & 0xf];
+    d >>= 4;
+  }
+  rev_syscall4(64, 1, (long)line, sizeof(line)-1, 0);   // write
+}
+
+int main(int argc, char **argv){
+  unsigned long digest = 0xcbf29ce484222325UL;
+  int r = 0;
+  int i = 0;
+
+  // the checkpoint is taken part way through these rounds; the
+  // registers, stack, bss and heap must all survive the restore for
+  // the resumed run to print the same digest as an uninterrupted one
+  long *p = (long *)(malloc(N*sizeof(long)));
+  for( i=0; i<N; i++ ){
+    data[i] = i;
+    p[i] = N-i;
+  }
+  for( r=0; r<ROUNDS; r++ ){
+    for( i=0; i<N; i++ ){
+      data[i] = data[i] * 3 + p[(i + r) % N];
+      p[i] ^= data[i] >> 1;
+      digest = (digest ^ (unsigned long)(data[i] + p[i])) * 0x100000001b3UL;
+    }
+  }
+
+  print_digest(digest);
+  return 0;
+}
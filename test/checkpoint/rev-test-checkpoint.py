@@ -0,0 +1,51 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-checkpoint.py
+#
+
+import os
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 5,                                # Verbosity
+        "numCores" : 1,                               # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[0:RV64G]",                      # Core:Config; RV64G for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "checkpoint.exe"),  # Target executable
+        "splash" : 1                                  # Display the splash message
+})
+
+# CKPT_MODE=write runs until the checkpoint and exits,
+# CKPT_MODE=restore resumes from it, CKPT_MODE=none runs uninterrupted
+ckpt_mode = os.getenv("CKPT_MODE", "write")
+if ckpt_mode == "write":
+  comp_cpu.addParams({
+        "checkpoint" : "checkpoint.img",              # Checkpoint file
+        "checkpointInst" : 100000,                    # Retired instructions before the checkpoint
+        "checkpointExit" : 1                          # Exit once written
+  })
+elif ckpt_mode == "restore":
+  comp_cpu.addParams({
+        "restore" : "checkpoint.img"                  # Resume from the checkpoint
+  })
+
+sst.setStatisticOutput("sst.statOutputCSV")
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
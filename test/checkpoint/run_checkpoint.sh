@@ -0,0 +1,40 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f checkpoint.exe ]; then
+  # the reference run goes straight through
+  CKPT_MODE=none sst --add-lib-path=../../build/src/ ./rev-test-checkpoint.py > reference.log 2>&1
+  REF=$(grep "checkpoint digest:" reference.log)
+  if [ -z "$REF" ]; then
+    echo "Test TEST_CHECKPOINT: reference run printed no digest"
+    exit 1
+  fi
+  # the second run stops at the checkpoint, before the digest is printed
+  if ! CKPT_MODE=write sst --add-lib-path=../../build/src/ ./rev-test-checkpoint.py > checkpoint.log 2>&1; then
+    echo "Test TEST_CHECKPOINT: checkpoint run failed"
+    exit 1
+  fi
+  if [ ! -f checkpoint.img ]; then
+    echo "Test TEST_CHECKPOINT: checkpoint.img was not written"
+    exit 1
+  fi
+  if grep -q "checkpoint digest:" checkpoint.log; then
+    echo "Test TEST_CHECKPOINT: checkpoint was taken after the program finished"
+    exit 1
+  fi
+  # the third run resumes from the checkpoint and must finish with the
+  # same digest as the reference run
+  CKPT_MODE=restore sst --add-lib-path=../../build/src/ ./rev-test-checkpoint.py > restore.log 2>&1
+  OUT=$(grep "checkpoint digest:" restore.log)
+  if [ "$OUT" != "$REF" ]; then
+    echo "Test TEST_CHECKPOINT: restored run printed '$OUT', expected '$REF'"
+    exit 1
+  fi
+  cat restore.log
+else
+  echo "Test TEST_CHECKPOINT: checkpoint.exe not Found - likely build failed"
+  exit 1
+fi
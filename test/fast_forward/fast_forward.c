@@ -0,0 +1,47 @@
+/*
+ * fast_forward.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 4096
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[N];
+
+int main(int argc, char **argv){
+  long sum = 0;
+  int i = 0;
+
+  // initialization is executed functionally
+  long *p = (long *)(malloc(N*sizeof(long)));
+  for( i=0; i<N; i++ ){
+    data[i] = i;
+    p[i] = N-i;
+  }
+
+  // end of the fast-forward region; ff_resume names the first
+  // instruction after the marker so the run script can stop on it by
+  // symbol as well and check both modes land on the same PC
+  asm volatile("addi x0, x0, 1 \n\t"
+               ".globl ff_resume \n\t"
+               "ff_resume: \n\t");
+
+  // the region of interest runs on the timed path
+  for( i=0; i<N; i++ ){
+    sum += data[i] + p[i];
+  }
+  assert(sum == ((long)(N)*N));
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# run fast-forward with spec $1; sets COUNT and PC from the verbose report
+ff_run() {
+  FF_SPEC="$1" sst --add-lib-path=../../build/src/ ./rev-test-fast_forward.py > "$2" 2>&1
+  COUNT=$(grep -o "Fast-forwarded [0-9]* instructions" "$2" | awk '{print $2}')
+  PC=$(grep -o "Core 0 resumes timed execution at PC=0x[0-9a-f]*" "$2" | sed 's/.*PC=//')
+}
+
+# Check that the exec was built...
+if [ -f fast_forward.exe ]; then
+  # stop on the marker instruction
+  ff_run marker marker.log
+  MARKER_COUNT=$COUNT
+  MARKER_PC=$PC
+  if [ -z "$MARKER_COUNT" ] || [ "$MARKER_COUNT" -lt 4096 ] || [ -z "$MARKER_PC" ]; then
+    echo "Test TEST_FAST_FORWARD: marker run stopped early ('$MARKER_COUNT' instructions, PC '$MARKER_PC')"
+    exit 1
+  fi
+  # stopping on the symbol after the marker must land on the same PC
+  # having retired the same instructions
+  ff_run sym:ff_resume sym.log
+  if [ "$COUNT" != "$MARKER_COUNT" ] || [ "$PC" != "$MARKER_PC" ]; then
+    echo "Test TEST_FAST_FORWARD: sym:ff_resume stopped at $PC after $COUNT instructions, marker at $MARKER_PC after $MARKER_COUNT"
+    exit 1
+  fi
+  # and so must fast-forwarding by that instruction count
+  ff_run "$MARKER_COUNT" count.log
+  if [ "$COUNT" != "$MARKER_COUNT" ] || [ "$PC" != "$MARKER_PC" ]; then
+    echo "Test TEST_FAST_FORWARD: $MARKER_COUNT instructions stopped at $PC, marker at $MARKER_PC"
+    exit 1
+  fi
+  cat marker.log
+else
+  echo "Test TEST_FAST_FORWARD: fast_forward.exe not Found - likely build failed"
+  exit 1
+fi
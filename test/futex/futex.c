@@ -0,0 +1,87 @@
+/*
+ * futex.c
+ *
+ * RISC-V ISA: RV64IA
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define NTHREADS 4
+#define NITERS 50
+#define STACK_SIZE 4096
+
+#define FUTEX_WAIT         0
+#define FUTEX_WAKE         1
+#define FUTEX_PRIVATE_FLAG 128
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+char stacks[NTHREADS][STACK_SIZE] __attribute__((aligned(16)));
+volatile int tids[NTHREADS];
+volatile int mutex;
+volatile long counter;
+
+static long futex(volatile int *uaddr, long op, long val){
+  return rev_syscall4(98, (long)(uaddr), op, val, 0);
+}
+
+// the classic three state futex mutex: 0 free, 1 locked, 2 contended
+static void lock(volatile int *m){
+  int c = __sync_val_compare_and_swap(m, 0, 1);
+  if( c == 0 )
+    return;
+  if( c != 2 )
+    c = __sync_lock_test_and_set(m, 2);
+  while( c != 0 ){
+    futex(m, FUTEX_WAIT | FUTEX_PRIVATE_FLAG, 2);
+    c = __sync_lock_test_and_set(m, 2);
+  }
+}
+
+static void unlock(volatile int *m){
+  if( __sync_fetch_and_sub(m, 1) != 1 ){
+    *m = 0;
+    futex(m, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1);
+  }
+}
+
+static void worker(long arg){
+  int i = 0;
+  for( i=0; i<NITERS; i++ ){
+    lock(&mutex);
+    counter++;
+    unlock(&mutex);
+  }
+}
+
+int main(int argc, char **argv){
+  long i = 0;
+
+  // hold the lock while the threads start so they all contend
+  lock(&mutex);
+  for( i=0; i<NTHREADS; i++ ){
+    assert(rev_thread_spawn(worker, i, stacks[i]+STACK_SIZE, &tids[i]) > 0);
+  }
+  unlock(&mutex);
+
+  // join: sleep until each child clears its TID
+  for( i=0; i<NTHREADS; i++ ){
+    int tid = tids[i];
+    while( tid != 0 ){
+      futex(&tids[i], FUTEX_WAIT, tid);
+      tid = tids[i];
+    }
+  }
+
+  assert(counter == (NTHREADS*NITERS));
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f futex.exe ]; then
+  sst --add-lib-path=../../build/src/ ./rev-test-futex.py
+else
+  echo "Test TEST_FUTEX: futex.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,71 @@
+/*
+ * host_threads.c
+ *
+ * RISC-V ISA: RV64IA
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define NTHREADS 8
+#define NITERS 512
+#define STACK_SIZE 4096
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+char stacks[NTHREADS][STACK_SIZE] __attribute__((aligned(16)));
+volatile int tids[NTHREADS];
+volatile int counter;
+
+static void amo_inc(volatile int *p){
+  int old;
+  asm volatile("amoadd.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(1) : "memory");
+}
+
+static void lrsc_inc(volatile int *p){
+  int tmp, fail;
+  asm volatile("1: \n\t"
+               "lr.w %0, (%2) \n\t"
+               "addi %0, %0, 1 \n\t"
+               "sc.w %1, %0, (%2) \n\t"
+               "bnez %1, 1b \n\t"
+               : "=&r"(tmp), "=&r"(fail)
+               : "r"(p)
+               : "memory");
+}
+
+// every worker increments the shared counter both ways; a lost update
+// from a torn AMO or a reservation that survives another core's store
+// leaves the final count short
+static void worker(long arg){
+  long i = 0;
+  for( i=0; i<NITERS; i++ ){
+    amo_inc(&counter);
+    lrsc_inc(&counter);
+  }
+}
+
+int main(int argc, char **argv){
+  long i = 0;
+
+  for( i=0; i<NTHREADS; i++ ){
+    assert(rev_thread_spawn(worker, i, stacks[i]+STACK_SIZE, &tids[i]) > 0);
+  }
+
+  // join: wait for every child to clear its TID
+  for( i=0; i<NTHREADS; i++ ){
+    while( tids[i] != 0 ){
+    }
+  }
+
+  assert(counter == (NTHREADS*NITERS*2));
+
+  return 0;
+}
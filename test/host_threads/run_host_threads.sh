@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f host_threads.exe ]; then
+  sst --add-lib-path=../../build/src/ ./rev-test-host_threads.py
+else
+  echo "Test TEST_HOST_THREADS: host_threads.exe not Found - likely build failed"
+  exit 1
+fi
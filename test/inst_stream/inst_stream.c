@@ -0,0 +1,46 @@
+/*
+ * inst_stream.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define ITERS 64
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+// each function starts its own stream window, so the hot loop
+// touches more windows than the smallest prefetcher holds
+__attribute__((noinline, aligned(512))) long f0(long x){ return x + 1; }
+__attribute__((noinline, aligned(512))) long f1(long x){ return x ^ 3; }
+__attribute__((noinline, aligned(512))) long f2(long x){ return x + (x >> 2); }
+__attribute__((noinline, aligned(512))) long f3(long x){ return x - 5; }
+
+int main(int argc, char **argv){
+  long x = 0;
+  long ref = 0;
+  int i = 0;
+
+  for( i=0; i<ITERS; i++ ){
+    x = f3(f2(f1(f0(x)))) & 0xFFFF;
+  }
+
+  // the same computation without leaving the window
+  for( i=0; i<ITERS; i++ ){
+    ref = ref + 1;
+    ref = ref ^ 3;
+    ref = ref + (ref >> 2);
+    ref = (ref - 5) & 0xFFFF;
+  }
+  assert(x == ref);
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-inst_stream.py
+#
+
+import os
+import sst
+
+VERBOSE = 2
+MEM_SIZE = 1024*1024*1024-1
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 3,                                # Verbosity
+        "numCores" : 1,                               # Number of cores
+	"clock" : "2.0GHz",                           # Clock
+        "memSize" : MEM_SIZE,                         # Memory size in bytes
+        "machine" : os.getenv("REV_MACHINE", "[0:RV64G]"),  # Core:Config; RV64G for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:1]",                        # Fixed memory costs keep the runs comparable
+        "program" : os.getenv("REV_EXE", "inst_stream.exe"),  # Target executable
+        "prefetchDepth" : "[0:16]",                   # Instructions per stream window
+        "prefetchStreams" : "[0:%s]" % os.getenv("REV_STREAMS", "8"),  # Stream slots
+        "enable_memH" : 1,                            # Enable memHierarchy support
+        "splash" : 1                                  # Display the splash message
+})
+comp_cpu.enableAllStatistics()
+
+# Create the RevMemCtrl subcomponent
+comp_lsq = comp_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl");
+comp_lsq.addParams({
+      "verbose"         : "5",
+      "clock"           : "2.0Ghz",
+      "max_loads"       : 16,
+      "max_stores"      : 16,
+      "max_flush"       : 16,
+      "max_llsc"        : 16,
+      "max_readlock"    : 16,
+      "max_writeunlock" : 16,
+      "max_custom"      : 16,
+      "ops_per_cycle"   : 16
+})
+comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+iface.addParams({
+      "verbose" : VERBOSE
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "2GHz",
+    "verbose" : VERBOSE,
+    "addr_range_start" : 0,
+    "addr_range_end" : MEM_SIZE,
+    "backing" : "malloc"
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "8GB"
+})
+
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : os.getenv("REV_STATS", "inst_stream.csv")})
+
+link_iface_mem = sst.Link("link_iface_mem")
+link_iface_mem.connect( (iface, "port", "50ps"), (memctrl, "direct_link", "50ps") )
+
+# EOF
@@ -0,0 +1,34 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f inst_stream.exe ] && [ -f inst_stream_c.exe ]; then
+  rm -f inst_stream.*.csv
+  for S in 2 8; do
+    if ! REV_STREAMS=$S REV_STATS=inst_stream.$S.csv sst --add-lib-path=../../build/src/ ./rev-test-inst_stream.py > inst_stream.$S.log 2>&1; then
+      echo "Test TEST_INST_STREAM: prefetchStreams=$S run failed"
+      exit 1
+    fi
+  done
+
+  # two slots thrash on the five windows of the hot loop; eight hold them all
+  C2=$(../stat_value.sh inst_stream.2.csv TotalCycles core_0)
+  C8=$(../stat_value.sh inst_stream.8.csv TotalCycles core_0)
+  if [ "$C8" -eq 0 ] || [ "$C8" -ge "$C2" ]; then
+    echo "Test TEST_INST_STREAM: more stream slots did not help; 2 slots: $C2 cycles, 8 slots: $C8 cycles"
+    exit 1
+  fi
+
+  # compressed instructions straddle the line-sized fills and the
+  # stream windows, and the taken loop branches train the BTB
+  if ! REV_EXE=inst_stream_c.exe REV_MACHINE="[0:RV64GC]" REV_STATS=inst_stream.c.csv sst --add-lib-path=../../build/src/ ./rev-test-inst_stream.py > inst_stream.c.log 2>&1; then
+    echo "Test TEST_INST_STREAM: compressed run failed"
+    exit 1
+  fi
+  cat inst_stream.8.log
+else
+  echo "Test TEST_INST_STREAM: inst_stream.exe not Found - likely build failed"
+  exit 1
+fi
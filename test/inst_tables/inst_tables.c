@@ -0,0 +1,48 @@
+/*
+ * inst_tables.c
+ *
+ * RISC-V ISA: RV64IMAFDC
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 64
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+double a[N];
+double b[N];
+
+// integer, floating point and compressed encodings all come
+// from the instruction tables shared by like-configured cores
+static double dot(const double *x, const double *y, int n){
+  double sum = 0.0;
+  int i = 0;
+  for( i=0; i<n; i++ ){
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+int main(int argc, char **argv){
+  long isum = 0;
+  int i = 0;
+
+  for( i=0; i<N; i++ ){
+    a[i] = (double)(i);
+    b[i] = 2.0;
+    isum += i;
+  }
+
+  assert(isum == ((N*(N-1))/2));
+  assert(dot(a, b, N) == (double)(N*(N-1)));
+
+  return 0;
+}
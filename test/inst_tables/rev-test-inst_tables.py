@@ -0,0 +1,37 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-inst_tables.py
+#
+
+import os
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 6,                                # Verbosity
+        "numCores" : 4,                               # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[0:RV64GC,1:RV64IMAFDC,2:RV64GC,3:RV64IMAFDC]",  # Two machine models, two cores each
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "inst_tables.exe"),  # Target executable
+        "splash" : 1                                  # Display the splash message
+})
+
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : "./inst_tables.csv"})
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
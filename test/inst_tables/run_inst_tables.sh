@@ -0,0 +1,24 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f inst_tables.exe ]; then
+  if ! sst --add-lib-path=../../build/src/ ./rev-test-inst_tables.py > inst_tables.log 2>&1; then
+    echo "Test TEST_INST_TABLES: simulation failed"
+    exit 1
+  fi
+
+  # the first core of each machine model builds its tables; the
+  # second core of each model must share them
+  SHARED=$(grep -c "Sharing instruction table" inst_tables.log)
+  if [ "$SHARED" -ne 2 ]; then
+    echo "Test TEST_INST_TABLES: expected 2 cores to share tables; found $SHARED"
+    exit 1
+  fi
+  tail -n 20 inst_tables.log
+else
+  echo "Test TEST_INST_TABLES: inst_tables.exe not Found - likely build failed"
+  exit 1
+fi
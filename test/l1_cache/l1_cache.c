@@ -0,0 +1,50 @@
+/*
+ * l1_cache.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 4096
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[N];
+
+int main(int argc, char **argv){
+  long sum = 0;
+  int i = 0;
+  int j = 0;
+
+  for( i=0; i<N; i++ ){
+    data[i] = i;
+  }
+
+  /* small working set; hits after the first pass */
+  for( j=0; j<4; j++ ){
+    for( i=0; i<256; i++ ){
+      sum += data[i];
+    }
+  }
+  assert(sum == (4*((256*255)/2)));
+
+  /* large working set; evicts dirty lines */
+  sum = 0;
+  for( i=0; i<N; i++ ){
+    data[i] += 1;
+  }
+  for( i=0; i<N; i++ ){
+    sum += data[i];
+  }
+  assert(sum == ((N*(N+1))/2));
+
+  return 0;
+}
@@ -0,0 +1,43 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-l1.py
+#
+
+import os
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 5,                                # Verbosity
+        "numCores" : 1,                               # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[0:RV64G]",                      # Core:Config; RV64G for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "l1_cache.exe"),  # Target executable
+        "enable_l1" : 1,                              # Enable the internal L1 cache model
+        "l1Size" : 4096,                              # 4KiB L1
+        "l1Ways" : 4,                                 # 4-way set associative
+        "l1LineSize" : 64,                            # 64 byte lines
+        "l1HitLatency" : 1,                           # 1 cycle hits
+        "l1MissLatency" : 20,                         # 20 cycle misses
+        "splash" : 1                                  # Display the splash message
+})
+
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : "./l1_cache.csv"})
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
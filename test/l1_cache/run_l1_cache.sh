@@ -0,0 +1,31 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f l1_cache.exe ]; then
+  rm -f l1_cache.csv
+  if ! sst --add-lib-path=../../build/src/ ./rev-test-l1.py > l1_cache.log 2>&1; then
+    echo "Test TEST_L1_CACHE: simulation failed"
+    exit 1
+  fi
+
+  # every sweep of the 32KiB array misses once per 64 byte line (512 lines
+  # for the init, update and sum sweeps, 32 for the first pass over the small
+  # working set); the later small set passes and the stack must hit
+  HITS=$(../stat_value.sh l1_cache.csv L1Hits)
+  MISSES=$(../stat_value.sh l1_cache.csv L1Misses)
+  if [ "$HITS" -le "$MISSES" ]; then
+    echo "Test TEST_L1_CACHE: expected mostly hits; hits=$HITS misses=$MISSES"
+    exit 1
+  fi
+  if [ "$MISSES" -lt 1568 ] || [ "$MISSES" -gt 4096 ]; then
+    echo "Test TEST_L1_CACHE: unexpected miss count; misses=$MISSES"
+    exit 1
+  fi
+  cat l1_cache.log
+else
+  echo "Test TEST_L1_CACHE: l1_cache.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,55 @@
+/*
+ * loader.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+#define X4(n)   (n), (n)+1, (n)+2, (n)+3
+#define X16(n)  X4(n), X4((n)+4), X4((n)+8), X4((n)+12)
+#define X64(n)  X16(n), X16((n)+16), X16((n)+32), X16((n)+48)
+#define X256(n) X64(n), X64((n)+64), X64((n)+128), X64((n)+192)
+#define X1K(n)  X256(n), X256((n)+256), X256((n)+512), X256((n)+768)
+#define X4K(n)  X1K(n), X1K((n)+1024), X1K((n)+2048), X1K((n)+3072)
+#define X16K(n) X4K(n), X4K((n)+4096), X4K((n)+8192), X4K((n)+12288)
+#define X64K(n) X16K(n), X16K((n)+16384), X16K((n)+32768), X16K((n)+49152)
+
+// memHierarchy runs sample the data segment to keep the timed run short
+#ifndef STRIDE
+#define STRIDE 1
+#endif
+
+#define NDATA (65536+16384)
+#define NBSS  (1024*1024)
+
+// 320KiB of initialized data spans more than one 256KiB RevMem page
+unsigned data[NDATA] = { X64K(0), X16K(65536) };
+
+// bss must read as zero without the loader writing it
+char bss[NBSS];
+
+int main(int argc, char **argv){
+  unsigned i = 0;
+
+  for( i=0; i<NDATA; i+=STRIDE ){
+    assert(data[i] == i);
+  }
+  assert(data[NDATA-1] == NDATA-1);
+
+  for( i=0; i<NBSS; i+=4096 ){
+    assert(bss[i] == 0);
+  }
+  assert(bss[NBSS-1] == 0);
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-loader-memh.py
+#
+
+import os
+import sst
+
+VERBOSE = 2
+MEM_SIZE = 1024*1024*1024-1
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 3,                                # Verbosity
+        "numCores" : 1,                               # Number of cores
+	"clock" : "2.0GHz",                           # Clock
+        "memSize" : MEM_SIZE,                         # Memory size in bytes
+        "machine" : "[0:RV64G]",                      # Core:Config; RV64G for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "loader_memh.exe"),  # Target executable
+        "enable_memH" : 1,                            # Enable memHierarchy support
+        "enable_preload" : int(os.getenv("REV_PRELOAD", "1")),  # Preload the image during init
+        "splash" : 1                                  # Display the splash message
+})
+comp_cpu.enableAllStatistics()
+
+# Create the RevMemCtrl subcomponent
+comp_lsq = comp_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl");
+comp_lsq.addParams({
+      "verbose"         : "5",
+      "clock"           : "2.0Ghz",
+      "max_loads"       : 16,
+      "max_stores"      : 16,
+      "max_flush"       : 16,
+      "max_llsc"        : 16,
+      "max_readlock"    : 16,
+      "max_writeunlock" : 16,
+      "max_custom"      : 16,
+      "ops_per_cycle"   : 16
+})
+comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+iface.addParams({
+      "verbose" : VERBOSE
+})
+
+# the preloaded image leaves bss unwritten; the mmap backing reads it as zero
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "2GHz",
+    "verbose" : VERBOSE,
+    "addr_range_start" : 0,
+    "addr_range_end" : MEM_SIZE,
+    "backing" : "mmap"
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "8GB"
+})
+
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : os.getenv("REV_STATS", "loader-memh.csv")})
+
+link_iface_mem = sst.Link("link_iface_mem")
+link_iface_mem.connect( (iface, "port", "50ps"), (memctrl, "direct_link", "50ps") )
+
+# EOF
@@ -0,0 +1,33 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f loader.exe ] && [ -f loader_memh.exe ]; then
+  # segments are bulk-copied page by page and bss is left untouched
+  if ! sst --add-lib-path=../../build/src/ ./rev-test-loader.py > loader.log 2>&1; then
+    echo "Test TEST_LOADER: RevMem run failed"
+    exit 1
+  fi
+  # a preloaded memHierarchy image must read bss as zero without the
+  # loader writing it; the timed load writes every data and bss line
+  rm -f loader-memh.*.csv
+  for P in 1 0; do
+    if ! REV_PRELOAD=$P REV_STATS=loader-memh.$P.csv sst --add-lib-path=../../build/src/ ./rev-test-loader-memh.py > loader-memh.$P.log 2>&1; then
+      echo "Test TEST_LOADER: memHierarchy enable_preload=$P run failed"
+      exit 1
+    fi
+  done
+  W1=$(../stat_value.sh loader-memh.1.csv WritePending)
+  W0=$(../stat_value.sh loader-memh.0.csv WritePending)
+  # 320KiB of data plus 1MiB of bss in 64 byte lines
+  if [ "$W0" -lt $((W1 + 5120 + 16384)) ]; then
+    echo "Test TEST_LOADER: preloaded run issued $W1 timed writes; timed load issued $W0"
+    exit 1
+  fi
+  cat loader.log loader-memh.1.log
+else
+  echo "Test TEST_LOADER: loader.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,65 @@
+/*
+ * memctrl.c
+ *
+ * RISC-V ISA: RV64IA
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#define NLINES 8
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+// each counter sits on its own 64 byte cache line
+struct line {
+  uint64_t v;
+  uint64_t pad[7];
+};
+
+struct line lines[NLINES] __attribute__((aligned(64)));
+
+uint64_t flag[NLINES];
+
+int main(int argc, char **argv){
+  int i = 0;
+  int j = 0;
+
+  // AMOs to independent lines may be in flight together
+  for( j=0; j<4; j++ ){
+    for( i=0; i<NLINES; i++ ){
+      __atomic_fetch_add(&lines[i].v, i+1, __ATOMIC_RELAXED);
+    }
+  }
+
+  // loads and stores to a line with an AMO in flight wait for it
+  for( i=0; i<NLINES; i++ ){
+    __atomic_fetch_add(&lines[i].v, 1, __ATOMIC_RELAXED);
+    lines[i].pad[0] = lines[i].v;
+  }
+
+  for( i=0; i<NLINES; i++ ){
+    assert(lines[i].v == (uint64_t)(4*(i+1)+1));
+    assert(lines[i].pad[0] == lines[i].v);
+  }
+
+  // fences only hold back the access classes in their successor set;
+  // the stores and loads on either side must still be ordered
+  for( i=0; i<NLINES; i++ ){
+    lines[i].pad[1] = i;
+    asm volatile("fence w,w" ::: "memory");
+    flag[i] = 1;
+    asm volatile("fence r,r" ::: "memory");
+    assert((flag[i] == 1) && (lines[i].pad[1] == (uint64_t)(i)));
+  }
+  asm volatile("fence rw,rw" ::: "memory");
+
+  return 0;
+}
@@ -0,0 +1,49 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f memctrl.exe ]; then
+  # a single AMO table entry serializes every AMO; a larger
+  # table lets AMOs to independent lines overlap
+  rm -f memctrl.*.csv
+  for A in 1 16; do
+    if ! REV_MAX_AMO=$A REV_STATS=memctrl.$A.csv sst --add-lib-path=../../build/src/ ./rev-test-memctrl.py > memctrl.$A.log 2>&1; then
+      echo "Test TEST_MEMCTRL: max_amo=$A run failed"
+      exit 1
+    fi
+    AMOS=$(../stat_value.sh memctrl.$A.csv AMOAddPending)
+    if [ "$AMOS" -lt 40 ]; then
+      echo "Test TEST_MEMCTRL: max_amo=$A issued $AMOS AMOs; expected at least 40"
+      exit 1
+    fi
+    FENCES=$(../stat_value.sh memctrl.$A.csv FencePending)
+    if [ "$FENCES" -lt 17 ]; then
+      echo "Test TEST_MEMCTRL: max_amo=$A queued $FENCES fences; expected at least 17"
+      exit 1
+    fi
+    # total latency covers the memory latency plus the queueing delay
+    for C in Read Write AMO; do
+      MEM=$(../stat_value.sh memctrl.$A.csv ${C}MemLatency)
+      TOTAL=$(../stat_value.sh memctrl.$A.csv ${C}TotalLatency)
+      if [ "$MEM" -eq 0 ] || [ "$TOTAL" -lt "$MEM" ]; then
+        echo "Test TEST_MEMCTRL: max_amo=$A bad $C latency; memory=$MEM total=$TOTAL"
+        exit 1
+      fi
+    done
+    if [ "$(../stat_value.sh memctrl.$A.csv RqstQDepth)" -eq 0 ]; then
+      echo "Test TEST_MEMCTRL: max_amo=$A never sampled a queued request"
+      exit 1
+    fi
+  done
+  # an empty AMO table could never admit an AMO and must be rejected
+  if REV_MAX_AMO=0 REV_STATS=memctrl.0.csv sst --add-lib-path=../../build/src/ ./rev-test-memctrl.py > memctrl.0.log 2>&1; then
+    echo "Test TEST_MEMCTRL: max_amo=0 was accepted"
+    exit 1
+  fi
+  cat memctrl.16.log
+else
+  echo "Test TEST_MEMCTRL: memctrl.exe not Found - likely build failed"
+  exit 1
+fi
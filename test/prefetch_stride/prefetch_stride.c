@@ -0,0 +1,44 @@
+/*
+ * prefetch_stride.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 1024
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[N];
+
+int main(int argc, char **argv){
+  long sum = 0;
+  int i = 0;
+
+  for( i=0; i<N; i++ ){
+    data[i] = i;
+  }
+
+  /* unit stride stream */
+  for( i=0; i<N; i++ ){
+    sum += data[i];
+  }
+  assert(sum == ((N*(N-1))/2));
+
+  /* strided stream across cache lines */
+  sum = 0;
+  for( i=0; i<N; i+=16 ){
+    sum += data[i];
+  }
+  assert(sum == 32256);
+
+  return 0;
+}
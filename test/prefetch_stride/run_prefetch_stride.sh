@@ -0,0 +1,26 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f prefetch_stride.exe ]; then
+  rm -f prefetch_stride.csv
+  if ! sst --add-lib-path=../../build/src/ ./rev-test-prefetch.py > prefetch_stride.log 2>&1; then
+    echo "Test TEST_PREFETCH_STRIDE: simulation failed"
+    exit 1
+  fi
+
+  # both loops are regular streams; the stride prefetcher must
+  # issue lines ahead of them and some of those must be used
+  ISSUED=$(../stat_value.sh prefetch_stride.csv PrefetchIssued)
+  USEFUL=$(../stat_value.sh prefetch_stride.csv PrefetchUseful)
+  if [ "$ISSUED" -eq 0 ] || [ "$USEFUL" -eq 0 ]; then
+    echo "Test TEST_PREFETCH_STRIDE: prefetcher inactive; issued=$ISSUED useful=$USEFUL"
+    exit 1
+  fi
+  cat prefetch_stride.log
+else
+  echo "Test TEST_PREFETCH_STRIDE: prefetch_stride.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,37 @@
+/*
+ * quantum.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 1024
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[N];
+
+int main(int argc, char **argv){
+  long sum = 0;
+  int i = 0;
+
+  // loads and stores must complete in the same number of core
+  // cycles when several are run per clock callback
+  for( i=0; i<N; i++ ){
+    data[i] = i;
+  }
+  for( i=0; i<N; i++ ){
+    sum += data[i];
+  }
+  assert(sum == (((long)(N)*(N-1))/2));
+
+  return 0;
+}
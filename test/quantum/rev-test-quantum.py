@@ -0,0 +1,38 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-quantum.py
+#
+
+import os
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 5,                                # Verbosity
+        "numCores" : 2,                               # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[CORES:RV64G]",                  # Core:Config; RV64G for all cores
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:1,1:1:1]",                  # Fixed memory costs keep the runs comparable
+        "program" : os.getenv("REV_EXE", "quantum.exe"),  # Target executable
+        "quantum" : int(os.getenv("REV_QUANTUM", "16")),  # Core cycles per clock callback
+        "splash" : 1                                  # Display the splash message
+})
+
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : os.getenv("REV_STATS", "quantum.csv")})
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
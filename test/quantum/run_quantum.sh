@@ -0,0 +1,30 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f quantum.exe ]; then
+  rm -f quantum.1.csv quantum.16.csv
+  for Q in 1 16; do
+    if ! REV_QUANTUM=$Q REV_STATS=quantum.$Q.csv sst --add-lib-path=../../build/src/ ./rev-test-quantum.py > quantum.$Q.log 2>&1; then
+      echo "Test TEST_QUANTUM: quantum=$Q run failed"
+      exit 1
+    fi
+  done
+
+  # running a quantum of core cycles per callback must not change
+  # the number of cycles any core simulates
+  for CORE in core_0 core_1; do
+    C1=$(../stat_value.sh quantum.1.csv TotalCycles $CORE)
+    C16=$(../stat_value.sh quantum.16.csv TotalCycles $CORE)
+    if [ "$C1" -eq 0 ] || [ "$C1" -ne "$C16" ]; then
+      echo "Test TEST_QUANTUM: $CORE cycles differ; quantum=1: $C1 quantum=16: $C16"
+      exit 1
+    fi
+  done
+  cat quantum.16.log
+else
+  echo "Test TEST_QUANTUM: quantum.exe not Found - likely build failed"
+  exit 1
+fi
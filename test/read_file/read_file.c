@@ -0,0 +1,97 @@
+/*
+ * read_file.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define DATA_SIZE 6000
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+struct iov {
+  void *base;
+  unsigned long len;
+};
+
+char buf[DATA_SIZE];
+char small[16];
+
+// data.txt holds DATA_SIZE bytes of this pattern
+static int check(const char *p, long off, long len){
+  long i = 0;
+  for( i=0; i<len; i++ ){
+    long j = off + i;
+    char c = ((j % 64) == 63) ? '\n' : ('a' + (j % 26));
+    if( p[i] != c )
+      return 0;
+  }
+  return 1;
+}
+
+int main(int argc, char **argv){
+  struct iov v[2];
+  long rc = 0;
+
+  int fd = (int)rev_syscall4(56, AT_FDCWD, (long)"data.txt", 0, 0); // openat
+  assert(fd > 2);
+
+  // readv at the file offset: 10 bytes, then 4000 bytes across a page
+  v[0].base = small;
+  v[0].len  = 10;
+  v[1].base = buf;
+  v[1].len  = 4000;
+  rc = rev_syscall4(65, fd, (long)v, 2, 0);                         // readv
+  assert(rc == 4010);
+  assert(check(small, 0, 10));
+  assert(check(buf, 10, 4000));
+
+  // read the rest; a short read stops at the end of the file
+  rc = rev_syscall4(63, fd, (long)buf, DATA_SIZE, 0);               // read
+  assert(rc == (DATA_SIZE-4010));
+  assert(check(buf, 4010, DATA_SIZE-4010));
+  rc = rev_syscall4(63, fd, (long)buf, DATA_SIZE, 0);
+  assert(rc == 0);
+
+  // positional reads leave the file offset alone
+  rc = rev_syscall4(67, fd, (long)buf, 100, 4097);                  // pread64
+  assert(rc == 100);
+  assert(check(buf, 4097, 100));
+
+  v[0].len  = 7;
+  v[1].len  = 993;
+  rc = rev_syscall4(69, fd, (long)v, 2, 5000);                      // preadv
+  assert(rc == 1000);
+  assert(check(small, 5000, 7));
+  assert(check(buf, 5007, 993));
+
+  // a count far beyond the file is a short read, not a host allocation
+  rc = rev_syscall4(67, fd, (long)buf, 1L<<40, DATA_SIZE-10);
+  assert(rc == 10);
+  assert(check(buf, DATA_SIZE-10, 10));
+
+  // iovec lengths that overflow a ssize_t are rejected
+  v[0].len  = 1UL<<62;
+  v[1].len  = 1UL<<62;
+  rc = rev_syscall4(69, fd, (long)v, 2, 0);
+  assert(rc == -22);                                                // -EINVAL
+
+  rev_syscall4(57, fd, 0, 0, 0);                                    // close
+
+  // a closed fd is reported to the guest instead of ending the simulation
+  rc = rev_syscall4(63, fd, (long)buf, 10, 0);
+  assert(rc == -9);                                                 // -EBADF
+  rc = rev_syscall4(65, fd, (long)v, 2, 0);
+  assert(rc == -9);
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f read_file.exe ]; then
+  sst --add-lib-path=../../build/src/ ./rev-test-read_file.py
+else
+  echo "Test TEST_READ_FILE: read_file.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# simulated time of the run logged in $1, in ns
+sim_ns() {
+  grep -o "simulated time: [0-9.]* [a-z]*" "$1" | \
+    awk '{ m = 1; if ($4 == "us") m = 1e3; else if ($4 == "ms") m = 1e6; else if ($4 == "s") m = 1e9;
+           printf "%d\n", $3 * m }'
+}
+
+# Check that the exec was built...
+if [ -f sampling.exe ]; then
+  # reference: every instruction on the timed path
+  SAMPLE=0 sst --add-lib-path=../../build/src/ ./rev-test-sampling.py > detailed.log 2>&1
+  DETAILED_NS=$(sim_ns detailed.log)
+  SAMPLE=1 sst --add-lib-path=../../build/src/ ./rev-test-sampling.py > sampled.log 2>&1
+  SAMPLED_NS=$(sim_ns sampled.log)
+  if [ -z "$DETAILED_NS" ] || [ -z "$SAMPLED_NS" ]; then
+    echo "Test TEST_SAMPLING: a run did not complete"
+    exit 1
+  fi
+
+  REPORT=$(grep -o "Sampled CPI: .*" sampled.log)
+  WINDOWS=$(echo "$REPORT" | sed -n 's/.*confidence, \([0-9]*\) windows.*/\1/p')
+  EST=$(echo "$REPORT" | sed -n 's/.*estimated cycles=\([0-9]*\).*/\1/p')
+  if [ -z "$WINDOWS" ] || [ "$WINDOWS" -lt 8 ]; then
+    echo "Test TEST_SAMPLING: expected at least 8 detailed windows: '$REPORT'"
+    exit 1
+  fi
+  # functional periods take no simulated time
+  if [ "$SAMPLED_NS" -ge "$DETAILED_NS" ]; then
+    echo "Test TEST_SAMPLING: sampled run took ${SAMPLED_NS}ns, detailed ${DETAILED_NS}ns"
+    exit 1
+  fi
+  # at 1GHz a cycle is a nanosecond; the extrapolated cycle count
+  # must land within 35% of the detailed run
+  if [ $((EST * 100)) -lt $((DETAILED_NS * 65)) ] || [ $((EST * 100)) -gt $((DETAILED_NS * 135)) ]; then
+    echo "Test TEST_SAMPLING: estimated $EST cycles, detailed run took $DETAILED_NS"
+    exit 1
+  fi
+  cat sampled.log
+else
+  echo "Test TEST_SAMPLING: sampling.exe not Found - likely build failed"
+  exit 1
+fi
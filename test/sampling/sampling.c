@@ -0,0 +1,49 @@
+/*
+ * sampling.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 4096
+#define PHASES 8
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[N];
+
+int main(int argc, char **argv){
+  unsigned long h = 1;
+  long sum = 0;
+  int p = 0;
+  int i = 0;
+
+  // alternate a load/store heavy phase with a register-only one so
+  // that the sampled windows see different CPIs; each phase is
+  // several sampling periods long
+  for( p=0; p<PHASES; p++ ){
+    for( i=0; i<N; i++ ){
+      data[(i*7) % N] += i;
+    }
+    for( i=0; i<N; i++ ){
+      h = h * 6364136223846793005UL + 1442695040888963407UL;
+      h ^= h >> 17;
+    }
+  }
+
+  for( i=0; i<N; i++ ){
+    sum += data[i];
+  }
+  assert(sum == (PHASES*((long)(N)*(N-1))/2));
+  assert(h != 0);
+
+  return 0;
+}
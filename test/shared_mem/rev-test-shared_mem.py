@@ -0,0 +1,98 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-shared_mem.py
+#
+
+import os
+import sst
+
+DEBUG_MEM = 0
+DEBUG_LEVEL = 10
+VERBOSE = 2
+MEM_SIZE = 1024*1024*1024-1
+RANKS = 2
+
+# Two RevCPU components share one memHierarchy backend and guest address
+# space; with sst -n/--num-ranks each component may land on its own rank.
+# Component 0 runs main and deals the threads it clones over the sched
+# links; component 1 starts idle and runs the threads it is sent
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({
+    "bus_frequency" : "2GHz"
+})
+
+cpus = []
+for r in range(RANKS):
+  comp_cpu = sst.Component("cpu%d" % r, "revcpu.RevCPU")
+  comp_cpu.addParams({
+        "verbose" : 6,                                # Verbosity
+        "numCores" : 2,                               # Number of cores
+        "clock" : "2.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[CORES:RV64G]",                  # Core:Config; RV64G for all cores
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
+        "program" : os.getenv("REV_EXE", "shared_mem.exe"),  # Target executable
+        "enable_memH" : 1,                            # Enable memHierarchy support
+        "memRanks" : RANKS,                           # Components sharing the backend
+        "memRank" : r,                                # Index of this component
+        "threadSched" : 1,                            # Schedule cloned threads across the cores
+        "splash" : 1                                  # Display the splash message
+  })
+  comp_cpu.enableAllStatistics()
+  cpus.append(comp_cpu)
+
+  comp_lsq = comp_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl");
+  comp_lsq.addParams({
+        "verbose"         : "5",
+        "clock"           : "2.0Ghz",
+        "max_loads"       : 16,
+        "max_stores"      : 16,
+        "max_flush"       : 16,
+        "max_llsc"        : 16,
+        "max_readlock"    : 16,
+        "max_writeunlock" : 16,
+        "max_custom"      : 16,
+        "ops_per_cycle"   : 16
+  })
+  comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+  iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+  iface.addParams({
+        "verbose" : VERBOSE
+  })
+
+  link_iface_bus = sst.Link("link_iface_bus%d" % r)
+  link_iface_bus.connect( (iface, "port", "50ps"), (bus, "high_network_%d" % r, "50ps") )
+
+# memRank 0 exchanges threads with every other component
+for r in range(1, RANKS):
+  link_sched = sst.Link("link_sched%d" % r)
+  link_sched.connect( (cpus[0], "sched_%d" % r, "1ns"), (cpus[r], "sched_0", "1ns") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : DEBUG_MEM,
+    "debug_level" : DEBUG_LEVEL,
+    "clock" : "2GHz",
+    "verbose" : VERBOSE,
+    "addr_range_start" : 0,
+    "addr_range_end" : MEM_SIZE,
+    "backing" : "malloc"
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "8GB"
+})
+
+link_bus_mem = sst.Link("link_bus_mem")
+link_bus_mem.connect( (bus, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+# EOF
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f shared_mem.exe ]; then
+  sst --add-lib-path=../../build/src/ ./rev-test-shared_mem.py > shared_mem.log 2>&1
+  # the writer must have run on the component that does not run main
+  if ! grep -q "memRank 1 adopted thread" shared_mem.log; then
+    echo "Test TEST_SHARED_MEM: no thread ran on memRank 1"
+    exit 1
+  fi
+  cat shared_mem.log
+else
+  echo "Test TEST_SHARED_MEM: shared_mem.exe not Found - likely build failed"
+  exit 1
+fi
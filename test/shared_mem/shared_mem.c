@@ -0,0 +1,76 @@
+/*
+ * shared_mem.c
+ *
+ * RISC-V ISA: RV64IA
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define N 256
+#define STACK_SIZE 4096
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+// initialized data is only delivered to the shared backend by memRank 0
+long table[4] = { 3, 5, 7, 11 };
+long data[N];
+volatile int ready;
+volatile long result;
+
+char stacks[2][STACK_SIZE] __attribute__((aligned(16)));
+volatile int tids[2];
+
+// the first thread main clones runs on memRank 1: it fills data from
+// the image memRank 0 delivered, then publishes it
+static void writer(long arg){
+  long i = 0;
+  int one = 1;
+  int old = 0;
+  for( i=0; i<N; i++ ){
+    data[i] = i * table[i % 4];
+  }
+  asm volatile("fence rw, w" : : : "memory");
+  asm volatile("amoswap.w %0, %2, (%1)" : "=r"(old) : "r"(&ready), "r"(one) : "memory");
+}
+
+// the second stays on memRank 0 and waits for the other component's stores
+static void reader(long arg){
+  long sum = 0;
+  long i = 0;
+  while( ready == 0 ){
+  }
+  asm volatile("fence r, rw" : : : "memory");
+  for( i=0; i<N; i++ ){
+    sum += data[i];
+  }
+  result = sum;
+}
+
+int main(int argc, char **argv){
+  long expect = 0;
+  long i = 0;
+
+  assert(rev_thread_spawn(writer, 0, stacks[0]+STACK_SIZE, &tids[0]) > 0);
+  assert(rev_thread_spawn(reader, 1, stacks[1]+STACK_SIZE, &tids[1]) > 0);
+
+  // join: each child clears its TID in the shared backend on exit
+  for( i=0; i<2; i++ ){
+    while( tids[i] != 0 ){
+    }
+  }
+
+  for( i=0; i<N; i++ ){
+    expect += i * table[i % 4];
+  }
+  assert(result == expect);
+
+  return 0;
+}
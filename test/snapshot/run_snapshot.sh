@@ -0,0 +1,30 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f snapshot.exe ]; then
+  # the first run loads the binary and writes the snapshot
+  if ! sst --add-lib-path=../../build/src/ ./rev-test-snapshot.py > snapshot.log 2>&1; then
+    echo "Test TEST_SNAPSHOT: initial run failed"
+    exit 1
+  fi
+  if [ ! -f snapshot.img ]; then
+    echo "Test TEST_SNAPSHOT: snapshot.img was not written"
+    exit 1
+  fi
+  # the second run must restore from the snapshot instead of reloading
+  if ! sst --add-lib-path=../../build/src/ ./rev-test-snapshot.py > snapshot.restore.log 2>&1; then
+    echo "Test TEST_SNAPSHOT: restored run failed"
+    exit 1
+  fi
+  if ! grep -q "Restored post-load image from snapshot" snapshot.restore.log; then
+    echo "Test TEST_SNAPSHOT: snapshot.img was not restored"
+    exit 1
+  fi
+  cat snapshot.restore.log
+else
+  echo "Test TEST_SNAPSHOT: snapshot.exe not Found - likely build failed"
+  exit 1
+fi
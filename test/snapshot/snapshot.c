@@ -0,0 +1,54 @@
+/*
+ * snapshot.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 1024
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long init[4] = { 1, 2, 3, 4 };
+long zero[N];
+
+// called with "snapshot.exe one two; so argc == 3"
+int main(int argc, char **argv){
+  long sum = 0;
+  int i = 0;
+
+  // arguments live in the restored stack image
+  assert(argc == 3);
+  assert(argv[1][0] == 'o');
+  assert(argv[1][1] == 'n');
+  assert(argv[1][2] == 'e');
+  assert(argv[2][0] == 't');
+  assert(argv[2][1] == 'w');
+  assert(argv[2][2] == 'o');
+
+  // initialized data and bss live in the restored segments
+  for( i=0; i<4; i++ ){
+    sum += init[i];
+  }
+  assert(sum == 10);
+  for( i=0; i<N; i++ ){
+    assert(zero[i] == 0);
+  }
+
+  // the heap bounds are restored as well
+  long *p = (long *)(malloc(N*sizeof(long)));
+  for( i=0; i<N; i++ ){
+    p[i] = i;
+  }
+  assert(p[N-1] == (N-1));
+
+  return 0;
+}
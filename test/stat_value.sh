@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# stat_value.sh
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# Prints the accumulated sum of a statistic from an sst.statOutputCSV file,
+# summed over every component (and optional subid) that reports it
+#
+# usage: stat_value.sh <csv file> <statistic name> [statistic subid]
+#
+
+if [ $# -lt 2 ] || [ ! -f "$1" ]; then
+  echo 0
+  exit 1
+fi
+
+awk -F',' -v Stat="$2" -v SubId="$3" '
+  function trim(s){ gsub(/^[ \t]+|[ \t]+$/, "", s); return s }
+  NR == 1 {
+    for( i=1; i<=NF; i++ ){
+      h = trim($i)
+      if( h == "StatisticName" ) NameCol = i
+      if( h == "StatisticSubId" ) SubCol = i
+      if( h ~ /^Sum\./ ) SumCol = i
+    }
+    next
+  }
+  trim($NameCol) == Stat && (SubId == "" || trim($SubCol) == SubId) { Total += trim($SumCol) }
+  END { printf "%d\n", Total }
+' "$1"
+
+# EOF
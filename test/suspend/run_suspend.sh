@@ -0,0 +1,34 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f suspend.exe ]; then
+  rm -f suspend.0.csv suspend.1.csv
+  for S in 0 1; do
+    if ! REV_SUSPEND=$S REV_STATS=suspend.$S.csv sst --add-lib-path=../../build/src/ ./rev-test-suspend.py > suspend.$S.log 2>&1; then
+      echo "Test TEST_SUSPEND: enable_suspend=$S run failed"
+      exit 1
+    fi
+  done
+
+  # suspending the clock while the core waits on memory must not
+  # change the simulated cycles or the retired instructions
+  C0=$(../stat_value.sh suspend.0.csv TotalCycles core_0)
+  C1=$(../stat_value.sh suspend.1.csv TotalCycles core_0)
+  if [ "$C0" -eq 0 ] || [ "$C0" -ne "$C1" ]; then
+    echo "Test TEST_SUSPEND: cycles differ; enable_suspend=0: $C0 enable_suspend=1: $C1"
+    exit 1
+  fi
+  I0=$(grep -o "Inst Retired: [0-9]*" suspend.0.log)
+  I1=$(grep -o "Inst Retired: [0-9]*" suspend.1.log)
+  if [ -z "$I0" ] || [ "$I0" != "$I1" ]; then
+    echo "Test TEST_SUSPEND: retired instructions differ; enable_suspend=0: $I0 enable_suspend=1: $I1"
+    exit 1
+  fi
+  cat suspend.1.log
+else
+  echo "Test TEST_SUSPEND: suspend.exe not Found - likely build failed"
+  exit 1
+fi
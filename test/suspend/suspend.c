@@ -0,0 +1,42 @@
+/*
+ * suspend.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 512
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long next[N];
+
+int main(int argc, char **argv){
+  long sum = 0;
+  long cur = 0;
+  int i = 0;
+
+  // link the array into a chain that strides across cache lines
+  for( i=0; i<N; i++ ){
+    next[i] = (i+17) % N;
+  }
+
+  // every load depends on the previous one, so the core spends
+  // most of its cycles waiting on memHierarchy with its clock suspended
+  for( i=0; i<N; i++ ){
+    sum += cur;
+    cur = next[cur];
+  }
+  assert(cur == 0);
+  assert(sum == (((long)(N)*(N-1))/2));
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f syscall_state.exe ]; then
+  sst --add-lib-path=../../build/src/ ./rev-test-syscall_state.py
+else
+  echo "Test TEST_SYSCALL_STATE: syscall_state.exe not Found - likely build failed"
+  exit 1
+fi
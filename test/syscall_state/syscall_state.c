@@ -0,0 +1,79 @@
+/*
+ * syscall_state.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define NTHREADS 4
+#define NITERS 4
+#define STACK_SIZE 4096
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+// the same file under paths of different lengths; openat reads the
+// path a character per pass, so the threads are switched out mid-ecall
+const char *paths[NTHREADS] = {
+  "syscall_state.c",
+  "./syscall_state.c",
+  "../syscall_state/syscall_state.c",
+  "../syscall_state/./././syscall_state.c",
+};
+const char head[] = "/*\n * syscall_state.c";
+
+char stacks[NTHREADS][STACK_SIZE] __attribute__((aligned(16)));
+char bufs[NTHREADS][32];
+volatile int tids[NTHREADS];
+volatile long results[NTHREADS];
+
+static void worker(long arg){
+  long i = 0;
+  long j = 0;
+  long ok = 0;
+  for( i=0; i<NITERS; i++ ){
+    int fd = (int)rev_syscall4(56, AT_FDCWD, (long)paths[arg], 0, 0);   // openat
+    if( fd < 3 )
+      continue;
+    long rc = rev_syscall4(63, fd, (long)bufs[arg], sizeof(head)-1, 0); // read
+    rev_syscall4(57, fd, 0, 0, 0);                                      // close
+    if( rc != (long)(sizeof(head)-1) )
+      continue;
+    for( j=0; j<rc; j++ ){
+      if( bufs[arg][j] != head[j] )
+        break;
+    }
+    if( j == rc )
+      ok++;
+  }
+  results[arg] = ok;
+}
+
+int main(int argc, char **argv){
+  long i = 0;
+
+  for( i=0; i<NTHREADS; i++ ){
+    assert(rev_thread_spawn(worker, i, stacks[i]+STACK_SIZE, &tids[i]) > 0);
+  }
+
+  // join: wait for every child to clear its TID
+  for( i=0; i<NTHREADS; i++ ){
+    while( tids[i] != 0 ){
+    }
+  }
+
+  // every open saw its own path and every read its own buffer
+  for( i=0; i<NTHREADS; i++ ){
+    assert(results[i] == NITERS);
+  }
+
+  return 0;
+}
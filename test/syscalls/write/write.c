@@ -16,12 +16,22 @@ int main() {
     rev_exit(1);
   }
 
-    //The test below fails - we are reaching into invalid address space, this appears unrealted to most recent changes
-/*  const char msg3[98] = "Greetings - this is a much longer message and some nice text, in fact, it is bigger than 64 bytes\n"; 
+  const char msg3[98] = "Greetings - this is a much longer message and some nice text, in fact, it is bigger than 64 bytes\n";
   ssize_t bytes_written3 = rev_write(STDOUT_FILENO, msg3, sizeof(msg3));
 
-  if( bytes_written3 < 0 ){
+  if( bytes_written3 != sizeof(msg3) ){
     rev_exit(1);
-  }*/
+  }
+
+  // a buffer spanning several pages goes out in one write
+  static char big[3*4096+17];
+  for( unsigned i=0; i<sizeof(big); i++ ){
+    big[i] = ((i % 64) == 63) ? '\n' : ('a' + (i % 26));
+  }
+  ssize_t bytes_written4 = rev_write(STDOUT_FILENO, big, sizeof(big));
+
+  if( bytes_written4 != sizeof(big) ){
+    rev_exit(1);
+  }
   return 0;
 }
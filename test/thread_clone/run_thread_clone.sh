@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make clean && make
+
+# Check that the exec was built...
+if [ -f thread_clone.exe ]; then
+  sst --add-lib-path=../../build/src/ ./rev-test-thread_clone.py
+else
+  echo "Test TEST_THREAD_CLONE: thread_clone.exe not Found - likely build failed"
+  exit 1
+fi
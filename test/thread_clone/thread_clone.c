@@ -0,0 +1,56 @@
+/*
+ * thread_clone.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include "../../common/syscalls/threads.h"
+
+#define NTHREADS 4
+#define STACK_SIZE 4096
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+char stacks[NTHREADS][STACK_SIZE] __attribute__((aligned(16)));
+volatile int tids[NTHREADS];
+volatile long results[NTHREADS];
+
+// each thread runs ordinary C code on its own stack
+static void worker(long arg){
+  long sum = 0;
+  long i = 0;
+  for( i=0; i<=(arg+1)*10; i++ ){
+    sum += i;
+  }
+  results[arg] = sum;
+}
+
+int main(int argc, char **argv){
+  long i = 0;
+
+  for( i=0; i<NTHREADS; i++ ){
+    int tid = rev_thread_spawn(worker, i, stacks[i]+STACK_SIZE, &tids[i]);
+    assert(tid > 0);
+  }
+
+  // join: wait for every child to clear its TID
+  for( i=0; i<NTHREADS; i++ ){
+    while( tids[i] != 0 ){
+    }
+  }
+
+  for( i=0; i<NTHREADS; i++ ){
+    long n = (i+1)*10;
+    assert(results[i] == (n*(n+1))/2);
+  }
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * thread_sched.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define NTHREADS 4
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+volatile long done[NTHREADS];
+
+// the child shares the parent's stack, so its whole life is spent
+// in registers: mark the slot, then exit
+static void spawn(volatile long *slot){
+  asm volatile(
+    "mv t0, %0 \n\t"
+    "li a0, 0 \n\t"
+    "li a1, 0 \n\t"
+    "li a7, 220 \n\t"
+    "ecall \n\t"
+    "bnez a0, 1f \n\t"
+    "li t1, 1 \n\t"
+    "sd t1, 0(t0) \n\t"
+    "li a0, 0 \n\t"
+    "li a7, 93 \n\t"
+    "ecall \n\t"
+    "1: \n\t"
+    : : "r"(slot) : "t0", "t1", "a0", "a1", "a7", "memory");
+}
+
+int main(int argc, char **argv){
+  long count = 0;
+  int i = 0;
+
+  for( i=0; i<NTHREADS; i++ ){
+    spawn(&done[i]);
+  }
+
+  // the children only make progress if they run on the other cores
+  // (or preempt us); with pinned threads they would run first
+  while( count < NTHREADS ){
+    count = 0;
+    for( i=0; i<NTHREADS; i++ ){
+      count += done[i];
+    }
+  }
+  assert(count == NTHREADS);
+
+  return 0;
+}